@@ -2,28 +2,44 @@
 #define COMP_CONNECTION_HPP
 
 #include <comp/config.hpp>
+#include <comp/wrap/chrono.hpp>
+#include <comp/wrap/functional.hpp>
 #include <comp/wrap/memory.hpp>
 #include <comp/wrap/mutex.hpp>
+#include <comp/wrap/tuple.hpp>
+#include <comp/wrap/unordered_map.hpp>
 #include <comp/wrap/vector.hpp>
 #include <comp/wrap/type_traits.hpp>
 #include <comp/wrap/function_traits.hpp>
 #include <comp/utility/lockable.hpp>
+#include <comp/utility/memory_usage.hpp>
+#include <comp/utility/ref_counted.hpp>
+#include <comp/utility/slot_identity.hpp>
+#include <comp/utility/span.hpp>
 #include <comp/utility/tracker.hpp>
 
 namespace comp
 {
 
+class Dispatcher;
+
 /// Signal concept.
 class COMP_API SignalConcept : public comp::Lockable<comp::mutex>, public comp::DeleteObserver::Notifier
 {
 public:
     /// Destructor.
-    ~SignalConcept();
+    virtual ~SignalConcept();
 
-    /// The Connection to a signal.
-    class COMP_API ConnectionConcept : public comp::Lockable<comp::mutex>, public comp::DeleteObserver
+    /// The Connection to a signal. Connections are intrusively reference counted; the counter is
+    /// atomic only when the library is built thread-safe.
+    class COMP_API ConnectionConcept : public comp::Lockable<comp::mutex>, public comp::RefCounted<>, public comp::DeleteObserver
     {
+        friend class SignalConcept;
+
     public:
+        /// Destructor.
+        ~ConnectionConcept();
+
         /// Returns whether the connection object is valid. A connection object is valid when it
         /// is connected to a signal.
         bool isValid() const;
@@ -31,19 +47,111 @@ public:
         /// Disconnects the connection from the signal it is connected to.
         void disconnect();
 
+        /// Disconnects the connection, and waits until the activations of the slot in flight on
+        /// other threads complete. When the call returns, the slot is not running, and the objects
+        /// the slot uses can be destroyed. When called from the slot, the activation of the calling
+        /// thread is not waited for.
+        void disconnectAndWait();
+
+        /// Returns whether the slot of the connection is being activated. The activations from the
+        /// replicas of a sharded signal are counted by the signal, and are not reported.
+        bool isActive() const;
+
+        /// Delivers the activations the connection buffers, like the pending batch of a batched
+        /// connection. The other connections do nothing.
+        virtual void flush();
+
+        /// Returns the identity of the slot. Connections to lambdas and functors have null identity.
+        virtual SlotIdentity identity() const;
+
+        /// Returns whether the object the slot is bound to is destroyed. The signal disconnects the
+        /// expired connections on its next activation.
+        virtual bool isExpired() const;
+
+        /// Returns the class of the slot, used in the memory usage report.
+        virtual SlotClass slotClass() const;
+
+        /// Returns the size of the connection object, including the callable stored in it.
+        virtual size_t objectSize() const;
+
+        /// Returns the activation priority of the connection. Connections with higher priority
+        /// are activated first.
+        int priority() const
+        {
+            return m_priority;
+        }
+
     protected:
+        /// Counts an activation of the connection in flight for its lifetime.
+        class COMP_API ActivationGuard
+        {
+            COMP_DISABLE_COPY_OR_MOVE(ActivationGuard)
+
+        public:
+            /// Enters the activation of the \a connection. The activations from snapshots which
+            /// count their activations in flight themselves pass \e false as \a counted, and only
+            /// link the activation to the activations of the calling thread.
+            explicit ActivationGuard(ConnectionConcept& connection, bool counted = true);
+            /// Leaves the activation.
+            ~ActivationGuard();
+
+            /// Returns whether the slot skipped the activation.
+            bool isSkipped() const
+            {
+                return m_skipped;
+            }
+
+        private:
+            friend class ConnectionConcept;
+
+            ConnectionConcept& m_connection;
+            /// The activation the calling thread was running when this one started.
+            ActivationGuard* m_previous;
+            bool m_counted;
+            bool m_skipped = false;
+        };
+
         /// Constructor.
         explicit ConnectionConcept(SignalConcept& signal);
 
+        /// Returns the signal the connection is connected to, or nullptr if the connection is
+        /// disconnected. The signal changes when the connection is published by replaceSlots().
+        SignalConcept* signal() const
+        {
+            return m_signal.load();
+        }
+
         /// To perform connection specific cleanup when a connection disconnects, implement
         /// this method.
         virtual void disconnectOverride();
 
-    private:
+        /// Marks the activation of the connection the calling thread runs skipped. Call it from
+        /// the activation of the slot. The skipped activation does not count as activated.
+        void skipActivation();
+
+        /// Invalidates the connection without removing it from the signal. The signal drops the
+        /// invalid connections the next time it is activated. Invalidating takes a single atomic
+        /// operation, and succeeds only for one of the concurrent callers.
+        /// \return If the connection was valid and this call invalidated it, returns \e true,
+        ///         otherwise \e false.
+        bool invalidate();
+
         /// Overrides DeleteObserver::notifyDeleted().
         void notifyDeleted(Notifier&) override;
 
-        SignalConcept* m_signal = nullptr;
+    private:
+        /// The activation the calling thread runs.
+        static thread_local ActivationGuard* s_currentActivation;
+
+        comp::atomic<SignalConcept*> m_signal = nullptr;
+        /// The number of activations in flight.
+        comp::ref_counter m_activations{0};
+        /// The position of the connection in the container of an unordered signal.
+        size_t m_position = 0u;
+        int m_priority = 0;
+        /// The size the connection is accounted with in the memory usage of the slots.
+        size_t m_accountedSize = 0u;
+        SlotClass m_accountedClass = SlotClass::Other;
     };
 
     /// Returns whether the signal activation is blocked.
@@ -55,34 +163,277 @@ public:
     ///        pass \e false.
     void setBlocked(bool blocked);
 
-    /// Adds a connection to the signal.
+    /// Returns whether the signal connects the slots with the same identity only once.
+    /// \return If the signal has unique connections, returns \e true, otherwise \e false.
+    bool hasUniqueConnections() const;
+
+    /// Sets the unique connection mode of the signal. In unique connection mode, connecting a
+    /// function, a method of a receiver or a receiver signal that is already connected returns
+    /// the existing connection. Switching the mode on does not remove the existing duplicates.
+    /// \param unique To connect slots only once, pass \e true as argument, otherwise pass \e false.
+    void setUniqueConnections(bool unique);
+
+    /// Returns whether the signal keeps its connections unordered.
+    /// \return If the signal has unordered connections, returns \e true, otherwise \e false.
+    bool hasUnorderedConnections() const;
+
+    /// Sets the unordered connection mode of the signal. In unordered mode, the signal does not keep
+    /// the activation order of the slots, and ignores their priorities: new connections are appended,
+    /// and the removed connections are replaced with the last connection. Switching the mode on groups
+    /// the slots by their class, switching it off restores the priority order.
+    /// \param unordered To keep the connections unordered, pass \e true, otherwise pass \e false.
+    void setUnorderedConnections(bool unordered);
+
+    /// Groups the connections of an unordered signal by their slot class, so the slots of the same
+    /// class are activated one after the other. Ordered signals are not changed.
+    void regroupConnections();
+
+    /// Freezes the connections of the signal. The signal compacts its connections into an immutable
+    /// array, and activates them in place, without locking the signal or taking a snapshot of the
+    /// connections. The slots of a frozen signal can be disconnected, but connecting a slot throws
+    /// comp::frozen_signal. Freeze the signals which are wired once, like at startup. Waits for the
+    /// activations of an earlier freeze to complete. Called from a slot of a frozen activation of the
+    /// signal, the signal is frozen at once, and compacts its connections when the activation
+    /// completes.
+    void freeze();
+
+    /// Converts a frozen signal back, so it accepts new connections. The frozen array is released
+    /// when the activations which run it complete.
+    void thaw();
+
+    /// Returns whether the signal is frozen.
+    /// \return If the signal is frozen, returns \e true, otherwise \e false.
+    bool isFrozen() const;
+
+    /// Reserves storage for \a count connections. Reserve the storage before connecting a large
+    /// number of slots to avoid the repeated reallocation of the storage.
+    /// \param count The number of connections to reserve storage for.
+    void reserve(size_t count);
+
+    /// Returns the number of connections the signal can hold without reallocating its storage.
+    size_t capacity();
+
+    /// Releases the storage the signal does not use.
+    void shrinkToFit();
+
+    /// Returns whether the signal releases the unused storage automatically.
+    /// \return If the signal shrinks its storage automatically, returns \e true, otherwise \e false.
+    bool hasAutoShrink() const;
+
+    /// Sets the automatic shrink policy of the signal. When enabled, the signal releases the unused
+    /// storage when the connections drop below a quarter of a large storage, like after a burst of
+    /// temporary connections. The automatic shrink is enabled by default.
+    /// \param autoShrink To shrink the storage automatically, pass \e true, otherwise pass \e false.
+    void setAutoShrink(bool autoShrink);
+
+    /// Returns the memory used by the signal: the connection container, the slot identity index, the
+    /// observer lists, and the slots connected to the signal. The size of the index is estimated.
+    MemoryUsage memoryUsage();
+
+    /// Returns the total bytes used by the signal.
+    size_t bytesUsed();
+
+    /// Adds a connection to the signal. The connections are kept ordered by their priority, and the
+    /// connections with the same priority are kept in the order they were added. Adding a connection
+    /// with the lowest priority appends it in constant time. Adding a connection with a higher
+    /// priority inserts it in the container, which moves the connections after it, and takes linear
+    /// time.
     /// \param connection The connection to add.
-    void addConnection(comp::shared_ptr<ConnectionConcept> connection);
+    /// \param priority The activation priority of the connection.
+    /// \return The connection added. In unique connection mode, if a connection with the same
+    ///         identity exists, returns that connection, and the \a connection is not added. The
+    ///         existing connection is moved to the \a priority.
+    /// \throws comp::frozen_signal if the signal is frozen.
+    comp::intrusive_ptr<ConnectionConcept> addConnection(comp::intrusive_ptr<ConnectionConcept> connection, int priority = 0);
     /// Disconnects a connection.
     /// \param connection The connection to disconnect.
     void disconnect(ConnectionConcept& connection);
 
     /// Disconnects all the connections of a signal.
     void disconnect();
+
+    /// Flushes the connections of the signal, which deliver the activations they buffer.
+    void flush();
+
+    /// Disconnects the connections with the slot \a identity. The connections are looked up in the
+    /// slot identity index, and invalidated. The signal drops them on its next activation.
+    /// \param identity The identity of the slot to disconnect.
+    /// \return The number of connections disconnected.
+    int disconnect(const SlotIdentity& identity);
 protected:
 
     /// Removes a connection from the container.
     /// \param connection The connection to remove.
     void removeConnection(ConnectionConcept& connection);
 
-    using ConnectionContainer = comp::vector<comp::shared_ptr<ConnectionConcept>>;
+    /// Removes the invalid connections from the container. Call it with the signal locked.
+    void removeInvalidConnections();
+
+    /// Waits for the activations of the \a connection in flight, which run from the snapshots the
+    /// signal counts the activations of, like the replicas of the sharded signal. The default
+    /// implementation does nothing.
+    /// \param connection The disconnected connection.
+    /// \param ownActivations The number of uncounted activations of the connection the calling
+    ///        thread runs, which are not waited for.
+    virtual void waitForSnapshots(ConnectionConcept& connection, int ownActivations);
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    /// Blocks the calling thread until \a done returns \e true. The predicate is checked each time
+    /// an activation completes.
+    static void waitForActivations(const comp::function<bool()>& done);
+
+    /// Wakes up the threads waiting for activations. Call it when an activation completes.
+    static void notifyActivationDone();
+#endif
+
+    /// Replaces the connections of the signal with the connections of the \a staging signal. The
+    /// replaced connections are retired, and invalidated when no activation runs a snapshot taken
+    /// before the replace.
+    /// \param staging The signal with the new connections.
+    void replaceConnections(SignalConcept& staging);
+
+    /// Returns whether an activation runs a snapshot of the connections taken before the \a revision.
+    /// The signal activations are serialized, the default implementation checks the activation in
+    /// flight. Call it with the signal locked.
+    virtual bool hasSnapshotsBefore(unsigned revision);
+
+    /// Invalidates the retired connections, if no activation runs a snapshot holding them. Call it
+    /// without the signal locked, when an activation releases its snapshot.
+    void releaseRetiredConnections()
+    {
+        if (m_hasRetiredConnections)
+        {
+            invalidateRetiredConnections(false);
+        }
+    }
+
+    using ConnectionContainer = comp::vector<comp::intrusive_ptr<ConnectionConcept>>;
     /// The container with the signal connections.
     ConnectionContainer m_connections;
     /// Signal re-activation guard.
     comp::FlagGuard m_emitGuard;
+    /// The revision of the connection container, changes each time a connection is added to or
+    /// removed from the container.
+    comp::atomic<unsigned> m_revision = 0u;
+    /// The revision of the snapshot the activation in flight runs.
+    unsigned m_snapshotRevision = 0u;
+
+    /// The immutable connections of a frozen signal.
+    ConnectionContainer m_frozenConnections;
+
+    /// Counts an activation of a frozen signal, which runs its connections in place, for its lifetime.
+    class COMP_API FrozenActivationGuard
+    {
+        COMP_DISABLE_COPY_OR_MOVE(FrozenActivationGuard)
+
+    public:
+        /// Enters the activation of the \a signal.
+        explicit FrozenActivationGuard(SignalConcept& signal);
+        /// Leaves the activation, compacts the connections of a freeze() deferred by the
+        /// activation, and wakes up a freeze() waiting for the activation.
+        ~FrozenActivationGuard();
+
+        /// Returns whether the calling thread runs a frozen activation of the \a signal.
+        static bool isActiveOnThisThread(const SignalConcept& signal);
+
+    private:
+        SignalConcept& m_signal;
+        /// The frozen activation the calling thread was running when this one started.
+        FrozenActivationGuard* m_previous;
+        /// The frozen activation the calling thread runs.
+        static thread_local FrozenActivationGuard* s_current;
+    };
 
 private:
+    /// Builds the slot identity index from the connections.
+    void buildIndex();
+    /// Removes the \a connection from the slot identity index.
+    void unindex(ConnectionConcept& connection);
+    /// Shrinks the storage of the connections if the automatic shrink policy applies. Call it with
+    /// the signal locked.
+    void autoShrink();
+    /// Removes the connection at \a position from an unordered container, and moves the last
+    /// connection in its place.
+    void swapAndPop(size_t position);
+    /// Releases the frozen connections of a thawed signal, if no activation runs them. Call it with
+    /// the signal locked.
+    void releaseFrozenConnections();
+    /// Inserts the \a connection at the position of its priority. Call it with the signal locked.
+    void insertConnection(const comp::intrusive_ptr<ConnectionConcept>& connection);
+    /// Moves the \a connection to the position of the \a priority. Call it with the signal locked.
+    void reprioritize(const comp::intrusive_ptr<ConnectionConcept>& connection, int priority);
+    /// Compacts the connections into the frozen connections. Call it with the signal locked, when
+    /// no activation runs the frozen connections.
+    void compactFrozenConnections();
+    /// Invalidates the retired connections. Unless \a force is set, only if no activation runs a
+    /// snapshot holding them.
+    void invalidateRetiredConnections(bool force);
+
+    using SlotIndex = comp::unordered_multimap<SlotIdentity, ConnectionConcept*, SlotIdentity::Hash>;
+    /// The connections indexed by slot identity. The index is built the first time it is needed.
+    comp::unique_ptr<SlotIndex> m_index;
     /// The blocked state of the signal.
     comp::atomic_bool m_isBlocked = false;
+    /// The unique connection mode of the signal.
+    comp::atomic_bool m_uniqueConnections = false;
+    /// The unordered connection mode of the signal.
+    comp::atomic_bool m_unorderedConnections = false;
+    /// The automatic shrink policy of the signal.
+    comp::atomic_bool m_autoShrink = true;
+    /// The frozen state of the signal.
+    comp::atomic_bool m_isFrozen = false;
+    /// The number of activations running the frozen connections in place.
+    comp::ref_counter m_frozenActivations{0};
+    /// A freeze() called from a frozen activation, compacts the connections when the frozen
+    /// activations complete.
+    comp::atomic_bool m_freezePending = false;
+    /// The connections replaced while activations ran snapshots holding them.
+    ConnectionContainer m_retiredConnections;
+    /// The revision of the last replace which retired connections.
+    unsigned m_retiredRevision = 0u;
+    /// Whether the signal holds retired connections.
+    comp::atomic_bool m_hasRetiredConnections = false;
 };
 
 /// The pointer to a signal connection.
-using ConnectionPtr = comp::shared_ptr<SignalConcept::ConnectionConcept>;
+using ConnectionPtr = comp::intrusive_ptr<SignalConcept::ConnectionConcept>;
+
+/// A non-owning reference to a signal connection. Slots that take a ConnectionRef as first argument
+/// get the reference to their connection, which is valid while the slot runs, without touching the
+/// reference count of the connection. To keep the connection beyond the slot activation, retain it.
+class COMP_API ConnectionRef
+{
+    SignalConcept::ConnectionConcept* m_connection;
+
+public:
+    /// Constructor, references the \a connection.
+    explicit ConnectionRef(SignalConcept::ConnectionConcept& connection)
+        : m_connection(&connection)
+    {
+    }
+
+    /// Returns an owning pointer to the connection.
+    ConnectionPtr retain() const
+    {
+        return ConnectionPtr(m_connection);
+    }
+
+    SignalConcept::ConnectionConcept* operator->() const
+    {
+        return m_connection;
+    }
+    SignalConcept::ConnectionConcept& operator*() const
+    {
+        return *m_connection;
+    }
+};
+
+/// The type that stores the arguments of a signal activation: the decayed argument for signals with
+/// one argument, and the tuple of the decayed arguments for the other signals.
+template <typename... TArgs>
+using StoredArguments = conditional_t<sizeof...(TArgs) == 1u,
+                                      decay_t<typename comp::tuple_element<0u, comp::tuple<TArgs..., void>>::type>,
+                                      comp::tuple<decay_t<TArgs>...>>;
 
 /// The default result collector of a signal.
 template <typename TRet>
@@ -100,6 +451,23 @@ struct NullCollector<void>
 {
 };
 
+/// The collector which keeps the result of the last slot activated.
+template <typename TRet>
+struct LastRet
+{
+    TRet m_lastRet = TRet();
+    void collect(TRet& result)
+    {
+        m_lastRet = result;
+    }
+};
+
+/// Specialization for void signals.
+template <>
+struct LastRet<void>
+{
+};
+
 /// The signal concept implementation. To declare signals, use one of the Signal template
 /// specializations.
 /// \tparam TRet The return type of the signal
@@ -107,15 +475,46 @@ struct NullCollector<void>
 template <typename TRet, typename... TArgs>
 class COMP_TEMPLATE_API SignalConceptImpl : public SignalConcept
 {
+    template <typename Signature>
+    friend class SignalArray;
+
 public:
+    /// The return type of the signal.
+    using ReturnType = TRet;
+
+    /// The arguments of an activation, copied once and shared by the queued slots of the activation.
+    struct SharedArguments : public comp::RefCounted<>
+    {
+        explicit SharedArguments(TArgs&... args)
+            : arguments(args...)
+        {
+        }
+
+        /// The copy of the arguments.
+        const comp::tuple<decay_t<TArgs>...> arguments;
+    };
+    /// The pointer to the shared arguments of an activation.
+    using SharedArgumentsPtr = comp::intrusive_ptr<SharedArguments>;
+
     /// The slot, the connection of a signal to a function, a lambda, a method or an other signal.
     class COMP_TEMPLATE_API SlotType : public SignalConcept::ConnectionConcept
     {
     public:
-        /// Activates the slot, and collects the results using the \a collector.
+        /// Activates the slot, and collects the results using the \a collector. The activation is
+        /// counted in flight while the slot runs.
         /// \tparam TCollector The collector
+        /// \return If the connection is valid and the slot was activated, returns \e true. If the
+        ///         connection is invalid, or the slot skipped the activation, returns \e false.
         template <class TCollector>
-        void activate(TCollector& collector, TArgs&&... args);
+        bool activate(TCollector& collector, TArgs&&... args);
+
+        /// Activates the slot from a snapshot which counts the activations of its slots in flight,
+        /// like the replica of a sharded signal. The activation is not counted on the connection.
+        /// \tparam TCollector The collector
+        /// \return If the connection is valid and the slot was activated, returns \e true. If the
+        ///         connection is invalid, or the slot skipped the activation, returns \e false.
+        template <class TCollector>
+        bool activateUncounted(TCollector& collector, TArgs&&... args);
 
     protected:
         /// Constructor, creates a slot with a signal.
@@ -125,6 +524,15 @@ public:
         /// \param TArgs The arguments to pass to the slot.
         /// \return The return value of the slot.
         virtual TRet activateOverride(TArgs&&... args) = 0;
+
+        /// Runs the activation entered with the \a guard.
+        template <class TCollector>
+        bool activateIn(ActivationGuard& guard, TCollector& collector, TArgs&&... args);
+
+        /// Returns the shared copy of the arguments of the activation the calling thread runs. The
+        /// arguments are copied when the first slot of the activation asks for them, the other slots
+        /// of the activation get the same copy.
+        static SharedArgumentsPtr shareArguments(TArgs&... args);
     };
 
     /// Constructor.
@@ -145,26 +553,197 @@ public:
     template <class Collector = NullCollector<TRet>>
     int emit(Collector& collector, TArgs... args);
 
+    /// The virtual activation entry point of the signal. The operator() and the signals connected to
+    /// this signal activate it through this method, so the signals which activate their slots in
+    /// their own way override it.
+    /// \param lastResult The collector of the result of the last slot activated, or nullptr to
+    ///        ignore the results.
+    /// \param args The arguments to pass to the slots.
+    /// \return The number of connections activated, or -1 if the signal is blocked, or re-activated.
+    virtual int activate(LastRet<TRet>* lastResult, TArgs&&... args);
+
     /// Connects a \a method of a \a receiver to this signal.
     /// \param receiver The receiver of the connection.
     /// \param method The method to connect.
-    /// \return Returns the shared pointer to the connection.
+    /// \return Returns the pointer to the connection.
     template <class Method>
     enable_if_t<is_member_function_pointer_v<Method>, ConnectionPtr>
     connect(shared_ptr<typename function_traits<Method>::object> receiver, Method method);
 
     /// Connects a \a function, or a lambda to this signal.
     /// \param slot The function, functor or lambda to connect.
-    /// \return Returns the shared pointer to the connection.
+    /// \return Returns the pointer to the connection.
     template <class FunctionType>
     enable_if_t<!is_base_of_v<SignalConcept, FunctionType>, ConnectionPtr>
     connect(const FunctionType& function);
 
+    /// Connects a \a method of a \a receiver to this signal with an activation \a priority. Slots
+    /// with higher priority are activated first, slots with the same priority are activated in
+    /// the order they were connected. The default priority is 0.
+    /// \param priority The activation priority of the slot.
+    /// \param receiver The receiver of the connection.
+    /// \param method The method to connect.
+    /// \return Returns the pointer to the connection.
+    template <class Method>
+    enable_if_t<is_member_function_pointer_v<Method>, ConnectionPtr>
+    connect(int priority, shared_ptr<typename function_traits<Method>::object> receiver, Method method);
+
+    /// Connects a \a function, or a lambda to this signal with an activation \a priority.
+    /// \param priority The activation priority of the slot.
+    /// \param slot The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    enable_if_t<!is_base_of_v<SignalConcept, FunctionType>, ConnectionPtr>
+    connect(int priority, const FunctionType& function);
+
+    /// Connects a \a function, or a lambda to this signal, and binds the connection to the lifetime
+    /// of a \a tracked object. The object does not need to derive from DeleteObserver::Notifier. The
+    /// object is kept alive while the slot is activated, and the connection disconnects on the first
+    /// activation after the object is destroyed.
+    /// \param tracked The weak pointer to the object to track.
+    /// \param function The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class Tracked, class FunctionType>
+    ConnectionPtr connect(weak_ptr<Tracked> tracked, const FunctionType& function);
+
+    /// Connects a \a function, or a lambda to this signal through a \a dispatcher. The slot is not
+    /// invoked when the signal is activated: the signal posts the invocation with a copy of the
+    /// arguments to the dispatcher, and the slot is invoked when the dispatcher is drained. The
+    /// connection disconnects when the dispatcher is destroyed.
+    /// \param dispatcher The dispatcher that invokes the slot.
+    /// \param function The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    ConnectionPtr connect(Dispatcher& dispatcher, const FunctionType& function);
+
+    /// Connects a \a function, or a lambda to this signal through a \a dispatcher with a
+    /// \a priority. The dispatcher dispatches the invocations of higher priority first.
+    /// \param priority The priority of the slot.
+    /// \param dispatcher The dispatcher that invokes the slot.
+    /// \param function The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    ConnectionPtr connect(int priority, Dispatcher& dispatcher, const FunctionType& function);
+
+    /// Connects a \a function, or a lambda to this signal through the idle queue of a \a dispatcher.
+    /// The connection keeps at most one pending invocation in the idle queue. When the signal is
+    /// activated while an invocation is pending, the pending arguments are overwritten with the
+    /// newest ones, so the slot only receives the last arguments when the dispatcher flushes its
+    /// idle queue.
+    /// \param dispatcher The dispatcher that invokes the slot.
+    /// \param function The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    ConnectionPtr connectCoalesced(Dispatcher& dispatcher, const FunctionType& function);
+
+    /// Connects a batch \a function to this signal. The connection buffers the arguments of the
+    /// activations, and invokes the function with the span of the buffered arguments when \a maxBatch
+    /// activations are buffered, or on the first activation after \a maxDelay elapsed since the oldest
+    /// buffered activation. To deliver the pending batch, flush the connection or the signal. The
+    /// batch function is invoked with the connection locked, so the batches are delivered one at a
+    /// time, in order. The pending batch is delivered when the connection disconnects.
+    /// \param function The function, functor or lambda taking a span of StoredArguments.
+    /// \param maxBatch The maximum number of activations in a batch.
+    /// \param maxDelay The maximum time an activation waits in the batch.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    ConnectionPtr connectBatched(const FunctionType& function, size_t maxBatch, comp::chrono::nanoseconds maxDelay);
+
+    /// Connects a pure \a function, or a lambda to this signal, which is invoked only when the
+    /// arguments differ from the last arguments of the connection. The arguments are compared for
+    /// equality before the function is invoked. The activations with repeated arguments are skipped,
+    /// and do not count as activated. Functions returning a value give the result of the last
+    /// invocation to the collector when the arguments repeat.
+    /// \param function The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    ConnectionPtr connectMemoized(const FunctionType& function);
+
+    /// Connects a pure \a function, or a lambda to this signal, which is invoked only when the
+    /// \a hash of the arguments differs from the hash of the last arguments of the connection.
+    /// \param function The function, functor or lambda to connect.
+    /// \param hash The function which takes the arguments of the signal, and returns their hash.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType, class Hash>
+    ConnectionPtr connectMemoized(const FunctionType& function, const Hash& hash);
+
+    /// Connects a \a function, or a lambda to this signal, which is activated only once. The
+    /// connection is invalidated when the slot is activated, and the signal drops it the next time
+    /// it is activated.
+    /// \param function The function, functor or lambda to connect.
+    /// \return Returns the pointer to the connection.
+    template <class FunctionType>
+    ConnectionPtr connectOnce(const FunctionType& function);
+
     /// Creates a connection between this signal and a \a receiver signal.
     /// \param receiver The receiver signal connected to this signal.
-    /// \return Returns the shared pointer to the connection.
+    /// \return Returns the pointer to the connection.
     template <typename ReceiverResult, typename... TReceiverArgs>
     ConnectionPtr connect(SignalConceptImpl<ReceiverResult, TReceiverArgs...>& receiver);
+
+    using SignalConcept::disconnect;
+
+    /// Disconnects a \a function from this signal.
+    /// \param function The function to disconnect.
+    /// \return The number of connections disconnected.
+    template <class FunctionType>
+    enable_if_t<is_pointer_v<FunctionType> && is_function_v<remove_pointer_t<FunctionType>>, int>
+    disconnect(FunctionType function);
+
+    /// Disconnects a \a method of a \a receiver from this signal.
+    /// \param receiver The receiver of the connection.
+    /// \param method The method to disconnect.
+    /// \return The number of connections disconnected.
+    template <class Method>
+    enable_if_t<is_member_function_pointer_v<Method>, int>
+    disconnect(const shared_ptr<typename function_traits<Method>::object>& receiver, Method method);
+
+    /// Disconnects a \a receiver signal from this signal.
+    /// \param receiver The receiver signal to disconnect.
+    /// \return The number of connections disconnected.
+    template <typename ReceiverResult, typename... TReceiverArgs>
+    int disconnect(SignalConceptImpl<ReceiverResult, TReceiverArgs...>& receiver);
+
+    /// Replaces the slots of the signal with the slots a \a builder connects. The builder connects
+    /// the slots to a staging signal, and the signal publishes them in a single swap, so the signal
+    /// activations see either the old or the new slots. The old connections are invalidated, and
+    /// released when the activations that hold them complete.
+    /// \param builder The function which takes a SignalConceptImpl reference, and connects the slots
+    ///        to it.
+    /// \throws comp::frozen_signal if the signal is frozen.
+    template <class Builder>
+    void replaceSlots(const Builder& builder);
+
+protected:
+    /// Activates the slots of the \a connections, and collects the results using the \a collector.
+    /// The slots that throw bad_slot or bad_weak_ptr are disconnected.
+    /// \return The number of slots activated.
+    template <class Collector>
+    static int activateSlots(const ConnectionContainer& connections, Collector& collector, TArgs&&... args);
+
+    /// The scope of an activation, in which the slots share the copy of the arguments.
+    class COMP_TEMPLATE_API SharedArgumentsScope
+    {
+        friend class SlotType;
+
+        SharedArgumentsPtr m_arguments;
+        SharedArgumentsScope* m_previous;
+
+        COMP_DISABLE_COPY_OR_MOVE(SharedArgumentsScope)
+
+    public:
+        explicit SharedArgumentsScope()
+            : m_previous(s_sharedArguments)
+        {
+            s_sharedArguments = this;
+        }
+        ~SharedArgumentsScope()
+        {
+            s_sharedArguments = m_previous;
+        }
+    };
+    /// The activation scope of the calling thread.
+    static inline thread_local SharedArgumentsScope* s_sharedArguments = nullptr;
 };
 
 
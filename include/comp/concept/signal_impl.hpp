@@ -2,9 +2,12 @@
 #define COMP_SIGNAL_CONCEPT_IMPL_HPP
 
 #include <comp/concept/signal.hpp>
+#include <comp/dispatcher.hpp>
 #include <comp/wrap/memory.hpp>
 #include <comp/wrap/exception.hpp>
 #include <comp/wrap/functional.hpp>
+#include <comp/wrap/optional.hpp>
+#include <comp/wrap/tuple.hpp>
 #include <comp/wrap/utility.hpp>
 #include <comp/wrap/vector.hpp>
 
@@ -19,8 +22,32 @@ SignalConceptImpl<TRet, TArgs...>::SlotType::SlotType(SignalConcept& signal)
 
 template <typename TRet, typename... TArgs>
 template <class TCollector>
-void SignalConceptImpl<TRet, TArgs...>::SlotType::activate(TCollector& collector, TArgs&&... args)
+bool SignalConceptImpl<TRet, TArgs...>::SlotType::activate(TCollector& collector, TArgs&&... args)
 {
+    // Enter the activation before checking the validity, a concurrent disconnectAndWait() either
+    // sees the activation, or the activation sees the connection invalid.
+    ActivationGuard guard(*this);
+    return activateIn(guard, collector, comp::forward<TArgs>(args)...);
+}
+
+template <typename TRet, typename... TArgs>
+template <class TCollector>
+bool SignalConceptImpl<TRet, TArgs...>::SlotType::activateUncounted(TCollector& collector, TArgs&&... args)
+{
+    // The snapshot counts the activation before it gets here.
+    ActivationGuard guard(*this, false);
+    return activateIn(guard, collector, comp::forward<TArgs>(args)...);
+}
+
+template <typename TRet, typename... TArgs>
+template <class TCollector>
+bool SignalConceptImpl<TRet, TArgs...>::SlotType::activateIn(ActivationGuard& guard, TCollector& collector, TArgs&&... args)
+{
+    if (!this->isValid())
+    {
+        return false;
+    }
+
     if constexpr (comp::is_void_v<TRet>)
     {
         activateOverride(comp::forward<TArgs>(args)...);
@@ -30,12 +57,38 @@ void SignalConceptImpl<TRet, TArgs...>::SlotType::activate(TCollector& collector
         auto ret = activateOverride(comp::forward<TArgs>(args)...);
         collector.collect(ret);
     }
+    return !guard.isSkipped();
 }
 
 
+template <typename TRet, typename... TArgs>
+typename SignalConceptImpl<TRet, TArgs...>::SharedArgumentsPtr SignalConceptImpl<TRet, TArgs...>::SlotType::shareArguments(TArgs&... args)
+{
+    auto scope = s_sharedArguments;
+    if (!scope)
+    {
+        return comp::make_intrusive<SharedArguments>(args...);
+    }
+    if (!scope->m_arguments)
+    {
+        scope->m_arguments = comp::make_intrusive<SharedArguments>(args...);
+    }
+    return scope->m_arguments;
+}
+
 template <typename TRet, typename... TArgs>
 int SignalConceptImpl<TRet, TArgs...>::operator()(TArgs... args)
 {
+    return activate(nullptr, comp::forward<TArgs>(args)...);
+}
+
+template <typename TRet, typename... TArgs>
+int SignalConceptImpl<TRet, TArgs...>::activate(LastRet<TRet>* lastResult, TArgs&&... args)
+{
+    if (lastResult)
+    {
+        return emit(*lastResult, comp::forward<TArgs>(args)...);
+    }
     auto null = NullCollector<TRet>();
     return emit(null, comp::forward<TArgs>(args)...);
 }
@@ -49,42 +102,73 @@ int SignalConceptImpl<TRet, TArgs...>::emit(Collector& collector, TArgs... args)
         return -1;
     }
 
-    comp::lock_guard guard(m_emitGuard);
+    // Release the retired connections after unlocking the guard, a concurrent replace either sees the
+    // activation in flight, or the activation sees the connections it retired.
+    struct Release
+    {
+        SignalConceptImpl& signal;
+        ~Release()
+        {
+            signal.m_emitGuard.unlock();
+            signal.releaseRetiredConnections();
+        }
+    };
+    if (!m_emitGuard.try_lock())
+    {
+        return -1;
+    }
+    Release release{*this};
+
+    if (isFrozen())
+    {
+        // Enter the activation before checking the state, a concurrent thaw() either waits for the
+        // activation, or the activation sees the signal thawed.
+        FrozenActivationGuard frozen(*this);
+        if (isFrozen())
+        {
+            // The frozen connections do not change, activate them in place.
+            return activateSlots(m_frozenConnections, collector, comp::forward<TArgs>(args)...);
+        }
+    }
 
     ConnectionContainer connections;
     {
         comp::lock_guard lock(*this);
-        comp::erase_if(m_connections, [](auto& slot) { return !slot || !slot->isValid(); });
+        removeInvalidConnections();
         connections = m_connections;
+        m_snapshotRevision = m_revision.load(memory_order_relaxed);
     }
 
+    return activateSlots(connections, collector, comp::forward<TArgs>(args)...);
+}
+
+template <typename TRet, typename... TArgs>
+template <class Collector>
+int SignalConceptImpl<TRet, TArgs...>::activateSlots(const ConnectionContainer& connections, Collector& collector, TArgs&&... args)
+{
+    SharedArgumentsScope scope;
     int result = 0;
     for (auto& connection : connections)
     {
-        auto slot = comp::dynamic_pointer_cast<SlotType>(connection);
+        // The snapshot keeps the slot alive, no need to take an other reference.
+        auto slot = static_cast<SlotType*>(connection.get());
         COMP_ASSERT(slot);
-        comp::lock_guard lock(*slot);
 
         try
         {
-            if (!slot->isValid())
+            if (slot->activate(collector, comp::forward<TArgs>(args)...))
             {
-                continue;
+                ++result;
             }
-
-            ++result;
-            comp::relock_guard re(*slot);
-            slot->activate(collector, comp::forward<TArgs>(args)...);
         }
         catch (const comp::bad_slot&)
         {
-            comp::relock_guard re(*slot);
-            disconnect(*slot);
+            // The slot expired, it does not count as activated.
+            slot->disconnect();
         }
         catch (const comp::bad_weak_ptr&)
         {
-            comp::relock_guard re(*slot);
-            disconnect(*slot);
+            slot->disconnect();
         }
     }
 
@@ -95,6 +179,37 @@ int SignalConceptImpl<TRet, TArgs...>::emit(Collector& collector, TArgs... args)
 namespace
 {
 
+// Invokes a function slot. Passes the connection as first argument to the slots that take it, either
+// as ConnectionPtr or as ConnectionRef.
+template <typename Function, typename... Arguments>
+decltype(auto) invokeSlot(Function& function, SignalConcept::ConnectionConcept& connection, Arguments&&... args)
+{
+    if constexpr (function_traits<Function>::arity == 0u)
+    {
+        return comp::invoke(function, comp::forward<Arguments>(args)...);
+    }
+    else if constexpr (is_same_v<ConnectionPtr, typename function_traits<Function>::template argument<0u>::type>)
+    {
+        return comp::invoke(function, ConnectionPtr(&connection), comp::forward<Arguments>(args)...);
+    }
+    else if constexpr (is_same_v<ConnectionRef, typename function_traits<Function>::template argument<0u>::type>)
+    {
+        return comp::invoke(function, ConnectionRef(connection), comp::forward<Arguments>(args)...);
+    }
+    else
+    {
+        return comp::invoke(function, comp::forward<Arguments>(args)...);
+    }
+}
+
+// Whether a slot can be invoked with the shared, const copy of the arguments. The slots taking
+// non-const reference arguments, also after a connection argument, get their own copy.
+template <typename Function, typename... Arguments>
+constexpr bool acceptsConstArguments =
+    is_invocable_v<Function&, const Arguments&...> ||
+    is_invocable_v<Function&, ConnectionPtr, const Arguments&...> ||
+    is_invocable_v<Function&, ConnectionRef, const Arguments&...>;
+
 // A connection to a function or a static method.
 template <typename Function, typename TRet, typename... TArgs>
 class FunctionConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
@@ -108,21 +223,489 @@ public:
     {
     }
 
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Function;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+    SlotIdentity identity() const override
+    {
+        if constexpr (is_pointer_v<Function>)
+        {
+            return SlotIdentity::function(m_function);
+        }
+        else
+        {
+            return SlotIdentity();
+        }
+    }
+
+protected:
+    TRet activateOverride(TArgs&&... args) override
+    {
+        return invokeSlot(m_function, *this, comp::forward<TArgs>(args)...);
+    }
+};
+
+// A connection to a function or a lambda, activated only once.
+template <typename Function, typename TRet, typename... TArgs>
+class OnceConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    Function m_function;
+
+public:
+    explicit OnceConnection(SignalConcept& signal, const Function& function)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_function(function)
+    {
+    }
+
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Function;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+protected:
+    TRet activateOverride(TArgs&&... args) override
+    {
+        // Claim the activation. The signal drops the connection on its next activation.
+        if (!this->invalidate())
+        {
+            throw comp::bad_slot();
+        }
+        return invokeSlot(m_function, *this, comp::forward<TArgs>(args)...);
+    }
+};
+
+// Remembers the last arguments of a memoized connection, and compares them for equality.
+template <typename... TArgs>
+class EqualArguments
+{
+    comp::optional<comp::tuple<decay_t<TArgs>...>> m_last;
+
+public:
+    using Key = comp::tuple<decay_t<TArgs>...>;
+
+    bool matches(const TArgs&... args) const
+    {
+        return m_last && *m_last == comp::tie(args...);
+    }
+    Key key(const TArgs&... args) const
+    {
+        return Key(args...);
+    }
+    void remember(Key&& key)
+    {
+        m_last = comp::move(key);
+    }
+};
+
+// Remembers the hash of the last arguments of a memoized connection.
+template <typename Hash, typename... TArgs>
+class HashedArguments
+{
+    Hash m_hash;
+    comp::optional<size_t> m_last;
+
+public:
+    explicit HashedArguments(const Hash& hash)
+        : m_hash(hash)
+    {
+    }
+    using Key = size_t;
+
+    bool matches(const TArgs&... args) const
+    {
+        return m_last && *m_last == key(args...);
+    }
+    Key key(const TArgs&... args) const
+    {
+        return static_cast<size_t>(m_hash(args...));
+    }
+    void remember(Key key)
+    {
+        m_last = key;
+    }
+};
+
+// A connection to a function or a lambda, which skips the activations that repeat the last arguments.
+// Slots returning a value give the result of the last invocation on a repeated activation.
+template <typename Function, class Memo, typename TRet, typename... TArgs>
+class MemoizedConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    Function m_function;
+    Memo m_memo;
+    comp::optional<conditional_t<is_void_v<TRet>, bool, TRet>> m_lastResult;
+
+public:
+    explicit MemoizedConnection(SignalConcept& signal, const Function& function, const Memo& memo)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_function(function)
+        , m_memo(memo)
+    {
+    }
+
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Function;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+protected:
+    TRet activateOverride(TArgs&&... args) override
+    {
+        {
+            comp::lock_guard lock(*this);
+            // Only the value returning slots need a result to repeat.
+            if ((is_void_v<TRet> || m_lastResult) && m_memo.matches(args...))
+            {
+                this->skipActivation();
+                if constexpr (!is_void_v<TRet>)
+                {
+                    return *m_lastResult;
+                }
+                else
+                {
+                    return;
+                }
+            }
+        }
+
+        // Take the key before the slot consumes the arguments, and remember it only when the slot
+        // succeeds.
+        auto key = m_memo.key(args...);
+        if constexpr (is_void_v<TRet>)
+        {
+            invokeSlot(m_function, *this, comp::forward<TArgs>(args)...);
+
+            comp::lock_guard lock(*this);
+            m_memo.remember(comp::move(key));
+        }
+        else
+        {
+            auto result = invokeSlot(m_function, *this, comp::forward<TArgs>(args)...);
+
+            comp::lock_guard lock(*this);
+            m_memo.remember(comp::move(key));
+            m_lastResult = result;
+            return result;
+        }
+    }
+};
+
+// A connection to a function or a lambda, bound to the lifetime of a tracked object.
+template <class Tracked, typename Function, typename TRet, typename... TArgs>
+class TrackedFunctionConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    comp::weak_ptr<Tracked> m_tracked;
+    Function m_function;
+
+public:
+    explicit TrackedFunctionConnection(SignalConcept& signal, comp::weak_ptr<Tracked> tracked, const Function& function)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_tracked(tracked)
+        , m_function(function)
+    {
+    }
+
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Function;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+    bool isExpired() const override
+    {
+        return m_tracked.expired();
+    }
+
+protected:
+    TRet activateOverride(TArgs&&... args) override
+    {
+        auto tracked = m_tracked.lock();
+        if (!tracked)
+        {
+            throw comp::bad_slot();
+        }
+        return invokeSlot(m_function, *this, comp::forward<TArgs>(args)...);
+    }
+};
+
+// A connection to a function or a lambda, invoked through a dispatcher.
+template <typename Function, typename TRet, typename... TArgs>
+class QueuedConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    Dispatcher& m_dispatcher;
+    Function m_function;
+
+public:
+    explicit QueuedConnection(SignalConcept& signal, Dispatcher& dispatcher, const Function& function)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_dispatcher(dispatcher)
+        , m_function(function)
+    {
+    }
+
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Queued;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
 protected:
+    // The deleted dispatcher waits for the invocations the connection posts in flight.
+    void notifyDeleted(DeleteObserver::Notifier& object) override
+    {
+        if (&object != &m_dispatcher)
+        {
+            SignalConcept::ConnectionConcept::notifyDeleted(object);
+            return;
+        }
+        if (this->tryRetain())
+        {
+            auto keepAlive = ConnectionPtr(this, false);
+            this->disconnectAndWait();
+        }
+    }
+
     TRet activateOverride(TArgs&&... args) override
     {
-        if constexpr (function_traits<Function>::arity == 0u)
+        // The source is the signal activating the connection, the staging signal of replaceSlots()
+        // is gone by the time the slot is activated.
+        auto source = this->signal();
+        if (!source)
         {
-            return comp::invoke(m_function, comp::forward<TArgs>(args)...);
+            return;
         }
-        else if constexpr (is_same_v<ConnectionPtr, typename function_traits<Function>::template argument<0u>::type>)
+        if constexpr (acceptsConstArguments<Function, decay_t<TArgs>...>)
         {
-            auto connection = comp::dynamic_pointer_cast<SignalConcept::ConnectionConcept>(this->shared_from_this());
-            return comp::invoke(m_function, connection, comp::forward<TArgs>(args)...);
+            // The queued slots of the activation share one copy of the arguments.
+            auto invocation = [self = comp::intrusive_ptr<QueuedConnection>(this), shared = this->shareArguments(args...)]()
+            {
+                if (!self->isValid())
+                {
+                    return;
+                }
+                auto invoke = [&self](const auto&... args)
+                {
+                    invokeSlot(self->m_function, *self, args...);
+                };
+                comp::apply(invoke, shared->arguments);
+            };
+            m_dispatcher.post(source, this->priority(), comp::move(invocation));
         }
         else
         {
-            return comp::invoke(m_function, comp::forward<TArgs>(args)...);
+            // The slot modifies its arguments, it gets its own copy.
+            auto invocation = [self = comp::intrusive_ptr<QueuedConnection>(this), arguments = comp::tuple<decay_t<TArgs>...>(args...)]() mutable
+            {
+                if (!self->isValid())
+                {
+                    return;
+                }
+                auto invoke = [&self](auto&... args)
+                {
+                    invokeSlot(self->m_function, *self, args...);
+                };
+                comp::apply(invoke, arguments);
+            };
+            m_dispatcher.post(source, this->priority(), comp::move(invocation));
+        }
+    }
+};
+
+// A connection to a function or a lambda, invoked through the idle queue of a dispatcher with the
+// latest arguments.
+template <typename Function, typename TRet, typename... TArgs>
+class CoalescedConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    using Arguments = comp::tuple<decay_t<TArgs>...>;
+
+    Dispatcher& m_dispatcher;
+    Function m_function;
+    comp::optional<Arguments> m_pending;
+
+public:
+    explicit CoalescedConnection(SignalConcept& signal, Dispatcher& dispatcher, const Function& function)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_dispatcher(dispatcher)
+        , m_function(function)
+    {
+    }
+
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Queued;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+protected:
+    // The deleted dispatcher waits for the invocations the connection posts in flight.
+    void notifyDeleted(DeleteObserver::Notifier& object) override
+    {
+        if (&object != &m_dispatcher)
+        {
+            SignalConcept::ConnectionConcept::notifyDeleted(object);
+            return;
+        }
+        if (this->tryRetain())
+        {
+            auto keepAlive = ConnectionPtr(this, false);
+            this->disconnectAndWait();
+        }
+    }
+
+    TRet activateOverride(TArgs&&... args) override
+    {
+        {
+            comp::lock_guard lock(*this);
+            const auto posted = m_pending.has_value();
+            m_pending.emplace(args...);
+            if (posted)
+            {
+                return;
+            }
+        }
+
+        auto invocation = [self = comp::intrusive_ptr<CoalescedConnection>(this)]()
+        {
+            auto arguments = comp::optional<Arguments>();
+            {
+                comp::lock_guard lock(*self);
+                comp::swap(arguments, self->m_pending);
+            }
+            if (!arguments || !self->isValid())
+            {
+                return;
+            }
+            auto invoke = [&self](auto&... args)
+            {
+                invokeSlot(self->m_function, *self, args...);
+            };
+            comp::apply(invoke, *arguments);
+        };
+        m_dispatcher.postIdle(comp::move(invocation));
+    }
+};
+
+// A connection to a function or a lambda, invoked with the batches of the activation arguments.
+template <typename Function, typename TRet, typename... TArgs>
+class BatchedConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    using Clock = comp::chrono::steady_clock;
+    using Arguments = StoredArguments<TArgs...>;
+
+    // The connection the calling thread delivers a batch of.
+    static inline thread_local BatchedConnection* s_delivering = nullptr;
+
+    Function m_function;
+    comp::vector<Arguments> m_batch;
+    Clock::time_point m_oldest;
+    size_t m_maxBatch;
+    comp::chrono::nanoseconds m_maxDelay;
+    // Set when the connection disconnects, the activations in flight deliver right away.
+    bool m_closed = false;
+
+    // Delivers the batch, call it with the connection locked.
+    void deliver()
+    {
+        if (m_batch.empty())
+        {
+            return;
+        }
+
+        struct Delivering
+        {
+            BatchedConnection* previous;
+            ~Delivering()
+            {
+                s_delivering = previous;
+            }
+        } delivering{comp::exchange(s_delivering, this)};
+        comp::invoke(m_function, comp::span<const Arguments>(m_batch.data(), m_batch.size()));
+        // Keeps the capacity for the next batch.
+        m_batch.clear();
+    }
+
+public:
+    explicit BatchedConnection(SignalConcept& signal, const Function& function, size_t maxBatch, comp::chrono::nanoseconds maxDelay)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_function(function)
+        , m_maxBatch(maxBatch > 0u ? maxBatch : 1u)
+        , m_maxDelay(maxDelay)
+    {
+        m_batch.reserve(m_maxBatch);
+    }
+
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Queued;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this) + m_batch.capacity() * sizeof(Arguments);
+    }
+
+    void flush() override
+    {
+        comp::lock_guard lock(*this);
+        deliver();
+    }
+
+protected:
+    // Delivers the pending batch before the connection is invalidated.
+    void disconnectOverride() override
+    {
+        if (s_delivering == this)
+        {
+            // The batch function disconnects the connection, and holds the connection locked.
+            m_closed = true;
+            return;
+        }
+        comp::lock_guard lock(*this);
+        m_closed = true;
+        deliver();
+    }
+
+    TRet activateOverride(TArgs&&... args) override
+    {
+        comp::lock_guard lock(*this);
+        const auto now = Clock::now();
+        if (m_batch.empty())
+        {
+            m_oldest = now;
+        }
+        m_batch.emplace_back(args...);
+        if (m_closed || m_batch.size() >= m_maxBatch || now - m_oldest >= m_maxDelay)
+        {
+            deliver();
         }
     }
 };
@@ -132,16 +715,39 @@ template <class Target, typename Method, typename TRet, typename... TArgs>
 class MethodConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
 {
     comp::weak_ptr<Target> m_target;
+    // The address of the target, identifies the slot.
+    const void* m_targetAddress = nullptr;
     Method m_method;
 
 public:
     explicit MethodConnection(SignalConcept& signal, comp::shared_ptr<Target> target, const Method& method)
         : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
         , m_target(target)
+        , m_targetAddress(target.get())
         , m_method(method)
     {
     }
 
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Method;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+    SlotIdentity identity() const override
+    {
+        return SlotIdentity::method(m_targetAddress, m_method);
+    }
+
+    bool isExpired() const override
+    {
+        return m_target.expired();
+    }
+
 protected:
     TRet activateOverride(TArgs&&... args) override
     {
@@ -156,9 +762,13 @@ protected:
         }
         else if constexpr (is_same_v<ConnectionPtr, typename function_traits<Method>::template argument<0u>::type>)
         {
-            auto connection = comp::dynamic_pointer_cast<SignalConcept::ConnectionConcept>(this->shared_from_this());
+            auto connection = ConnectionPtr(this);
             return comp::invoke(m_method, slot, connection, comp::forward<TArgs>(args)...);
         }
+        else if constexpr (is_same_v<ConnectionRef, typename function_traits<Method>::template argument<0u>::type>)
+        {
+            return comp::invoke(m_method, slot, ConnectionRef(*this), comp::forward<TArgs>(args)...);
+        }
         else
         {
             return comp::invoke(m_method, slot, comp::forward<TArgs>(args)...);
@@ -166,20 +776,6 @@ protected:
     }
 };
 
-template <typename Ret>
-struct LastRet
-{
-    Ret m_lastRet = Ret();
-    void collect(Ret& result)
-    {
-        m_lastRet = result;
-    }
-};
-template <>
-struct LastRet<void>
-{
-};
-
 // A connection to an other signal with similar signature.
 template <class Receiver, typename TRet, typename... TArgs>
 class SignalConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
@@ -193,14 +789,37 @@ public:
     {
     }
 
+    SlotClass slotClass() const override
+    {
+        return SlotClass::Signal;
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+    SlotIdentity identity() const override
+    {
+        return SlotIdentity::receiver(m_receiver);
+    }
+
 protected:
-    TRet activateOverride(TArgs&&... args)
+    TRet activateOverride(TArgs&&... args) override
     {
-        auto collector = LastRet<TRet>();
-        m_receiver->emit(collector, comp::forward<TArgs>(args)...);
+        // Activate the receiver through its virtual entry point, the receiver may override it.
+        auto collector = LastRet<typename Receiver::ReturnType>();
+        m_receiver->activate(&collector, comp::forward<TArgs>(args)...);
         if constexpr (!comp::is_void_v<TRet>)
         {
-            return collector.m_lastRet;
+            if constexpr (comp::is_void_v<typename Receiver::ReturnType>)
+            {
+                return TRet();
+            }
+            else
+            {
+                return collector.m_lastRet;
+            }
         }
     }
 };
@@ -211,33 +830,54 @@ template <typename TRet, typename... TArgs>
 template <class FunctionType>
 enable_if_t<!is_base_of_v<SignalConcept, FunctionType>, ConnectionPtr>
 SignalConceptImpl<TRet, TArgs...>::connect(const FunctionType& function)
+{
+    return connect(0, function);
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+enable_if_t<!is_base_of_v<SignalConcept, FunctionType>, ConnectionPtr>
+SignalConceptImpl<TRet, TArgs...>::connect(int priority, const FunctionType& function)
 {
     using SlotReturnType = typename function_traits<FunctionType>::return_type;
     static_assert(
-        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...>) &&
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
         is_same_v<TRet, SlotReturnType>,
         "Incompatible slot signature");
 
-    auto connection = make_shared<FunctionConnection<FunctionType, TRet, TArgs...>>(*this, function);
-    addConnection(connection);
-    return connection;
+    auto connection = make_intrusive<FunctionConnection<FunctionType, TRet, TArgs...>>(*this, function);
+    return addConnection(connection, priority);
 }
 
 template <typename TRet, typename... TArgs>
 template <class Method>
 enable_if_t<is_member_function_pointer_v<Method>, ConnectionPtr>
 SignalConceptImpl<TRet, TArgs...>::connect(shared_ptr<typename function_traits<Method>::object> receiver, Method method)
+{
+    return connect(0, receiver, method);
+}
+
+template <typename TRet, typename... TArgs>
+template <class Method>
+enable_if_t<is_member_function_pointer_v<Method>, ConnectionPtr>
+SignalConceptImpl<TRet, TArgs...>::connect(int priority, shared_ptr<typename function_traits<Method>::object> receiver, Method method)
 {
     using Object = typename function_traits<Method>::object;
     using SlotReturnType = typename function_traits<Method>::return_type;
 
     static_assert(
-        (function_traits<Method>::template is_same_args<TArgs...>  || function_traits<Method>::template is_same_args<ConnectionPtr, TArgs...>) &&
+        (function_traits<Method>::template is_same_args<TArgs...>  || function_traits<Method>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<Method>::template is_same_args<ConnectionRef, TArgs...>) &&
         is_same_v<TRet, SlotReturnType>,
         "Incompatible slot signature");
 
-    auto connection = make_shared<MethodConnection<Object, Method, TRet, TArgs...>>(*this, receiver, method);
-    addConnection(connection);
+    auto connection = make_intrusive<MethodConnection<Object, Method, TRet, TArgs...>>(*this, receiver, method);
+    auto result = addConnection(connection, priority);
+    if (result != connection)
+    {
+        return result;
+    }
     if constexpr (is_base_of_v<DeleteObserver::Notifier, Object>)
     {
         connection->watch(*receiver);
@@ -245,6 +885,128 @@ SignalConceptImpl<TRet, TArgs...>::connect(shared_ptr<typename function_traits<M
     return connection;
 }
 
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connectOnce(const FunctionType& function)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
+        is_same_v<TRet, SlotReturnType>,
+        "Incompatible slot signature");
+
+    auto connection = make_intrusive<OnceConnection<FunctionType, TRet, TArgs...>>(*this, function);
+    addConnection(connection);
+    return connection;
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connect(Dispatcher& dispatcher, const FunctionType& function)
+{
+    return connect(0, dispatcher, function);
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connect(int priority, Dispatcher& dispatcher, const FunctionType& function)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
+        is_same_v<TRet, SlotReturnType>,
+        "Incompatible slot signature");
+    static_assert(is_void_v<TRet>, "Queued slots cannot return a value");
+
+    auto connection = make_intrusive<QueuedConnection<FunctionType, TRet, TArgs...>>(*this, dispatcher, function);
+    auto result = addConnection(connection, priority);
+    connection->watch(dispatcher);
+    return result;
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connectCoalesced(Dispatcher& dispatcher, const FunctionType& function)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
+        is_same_v<TRet, SlotReturnType>,
+        "Incompatible slot signature");
+    static_assert(is_void_v<TRet>, "Queued slots cannot return a value");
+
+    auto connection = make_intrusive<CoalescedConnection<FunctionType, TRet, TArgs...>>(*this, dispatcher, function);
+    auto result = addConnection(connection);
+    connection->watch(dispatcher);
+    return result;
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connectBatched(const FunctionType& function, size_t maxBatch, comp::chrono::nanoseconds maxDelay)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        function_traits<FunctionType>::template is_same_args<comp::span<const StoredArguments<TArgs...>>> &&
+        is_void_v<SlotReturnType>,
+        "Incompatible batch slot signature");
+    static_assert(is_void_v<TRet>, "Batched slots cannot return a value");
+
+    auto connection = make_intrusive<BatchedConnection<FunctionType, TRet, TArgs...>>(*this, function, maxBatch, maxDelay);
+    return addConnection(connection);
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connectMemoized(const FunctionType& function)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
+        is_same_v<TRet, SlotReturnType>,
+        "Incompatible slot signature");
+
+    using Memo = EqualArguments<TArgs...>;
+    auto connection = make_intrusive<MemoizedConnection<FunctionType, Memo, TRet, TArgs...>>(*this, function, Memo());
+    return addConnection(connection);
+}
+
+template <typename TRet, typename... TArgs>
+template <class FunctionType, class Hash>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connectMemoized(const FunctionType& function, const Hash& hash)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
+        is_same_v<TRet, SlotReturnType>,
+        "Incompatible slot signature");
+
+    using Memo = HashedArguments<Hash, TArgs...>;
+    auto connection = make_intrusive<MemoizedConnection<FunctionType, Memo, TRet, TArgs...>>(*this, function, Memo(hash));
+    return addConnection(connection);
+}
+
+template <typename TRet, typename... TArgs>
+template <class Tracked, class FunctionType>
+ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connect(weak_ptr<Tracked> tracked, const FunctionType& function)
+{
+    using SlotReturnType = typename function_traits<FunctionType>::return_type;
+    static_assert(
+        (function_traits<FunctionType>::template is_same_args<TArgs...> || function_traits<FunctionType>::template is_same_args<ConnectionPtr, TArgs...> ||
+         function_traits<FunctionType>::template is_same_args<ConnectionRef, TArgs...>) &&
+        is_same_v<TRet, SlotReturnType>,
+        "Incompatible slot signature");
+
+    auto connection = make_intrusive<TrackedFunctionConnection<Tracked, FunctionType, TRet, TArgs...>>(*this, tracked, function);
+    addConnection(connection);
+    return connection;
+}
+
 template <typename TRet, typename... TArgs>
 template <typename ReceiverResult, typename... TReceiverArgs>
 ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connect(SignalConceptImpl<ReceiverResult, TReceiverArgs...>& receiver)
@@ -256,12 +1018,55 @@ ConnectionPtr SignalConceptImpl<TRet, TArgs...>::connect(SignalConceptImpl<Recei
         is_same_v<std::tuple<TArgs...>, tuple<TReceiverArgs...>>,
         "incompatible signal signature");
 
-    auto connection = make_shared<SignalConnection<ReceiverSignal, TRet, TArgs...>>(*this, receiver);
-    addConnection(connection);
+    auto connection = make_intrusive<SignalConnection<ReceiverSignal, TRet, TArgs...>>(*this, receiver);
+    auto result = addConnection(connection);
+    if (result != connection)
+    {
+        return result;
+    }
     connection->watch(receiver);
     return connection;
 }
 
+template <typename TRet, typename... TArgs>
+template <class FunctionType>
+enable_if_t<is_pointer_v<FunctionType> && is_function_v<remove_pointer_t<FunctionType>>, int>
+SignalConceptImpl<TRet, TArgs...>::disconnect(FunctionType function)
+{
+    return disconnect(SlotIdentity::function(function));
+}
+
+template <typename TRet, typename... TArgs>
+template <class Method>
+enable_if_t<is_member_function_pointer_v<Method>, int>
+SignalConceptImpl<TRet, TArgs...>::disconnect(const shared_ptr<typename function_traits<Method>::object>& receiver, Method method)
+{
+    return disconnect(SlotIdentity::method(receiver.get(), method));
+}
+
+template <typename TRet, typename... TArgs>
+template <typename ReceiverResult, typename... TReceiverArgs>
+int SignalConceptImpl<TRet, TArgs...>::disconnect(SignalConceptImpl<ReceiverResult, TReceiverArgs...>& receiver)
+{
+    return disconnect(SlotIdentity::receiver(&receiver));
+}
+
+template <typename TRet, typename... TArgs>
+template <class Builder>
+void SignalConceptImpl<TRet, TArgs...>::replaceSlots(const Builder& builder)
+{
+    if (isFrozen())
+    {
+        throw comp::frozen_signal();
+    }
+
+    SignalConceptImpl staging;
+    staging.setUniqueConnections(hasUniqueConnections());
+    staging.setUnorderedConnections(hasUnorderedConnections());
+    builder(staging);
+    replaceConnections(staging);
+}
+
 } // namespace comp
 
 #endif // COMP_SIGNAL_CONCEPT_IMPL_HPP
@@ -42,6 +42,18 @@
 
 #define COMP_FALLTHROUGH     [[fallthrough]]
 
+// Requires the constant initialization of a static variable, where the compiler supports it.
+#if defined(__cpp_constinit)
+#   define COMP_CONSTINIT   constinit
+#elif defined(__clang__)
+#   define COMP_CONSTINIT   [[clang::require_constant_initialization]]
+#else
+#   define COMP_CONSTINIT
+#endif
+
+// The cache line size assumed when separating data written by different threads.
+#define COMP_CACHE_LINE_SIZE    64
+
 // unused parameters
 #define COMP_UNUSED(x)       (void)x
 
@@ -0,0 +1,92 @@
+#ifndef COMP_DISPATCHER_HPP
+#define COMP_DISPATCHER_HPP
+
+#include <comp/config.hpp>
+#include <comp/wrap/chrono.hpp>
+#include <comp/wrap/deque.hpp>
+#include <comp/wrap/functional.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/vector.hpp>
+#include <comp/utility/lockable.hpp>
+#include <comp/utility/tracker.hpp>
+
+namespace comp
+{
+
+/// The %Dispatcher defers slot invocations of queued connections to the thread that drains it, like
+/// the render thread of a game or UI loop. The invocations are dispatched in priority order. The
+/// sources of the invocations with the same priority, typically signals, are served round-robin, so
+/// a burst of emissions on one signal does not hold back the others.
+///
+/// Queued connections watch the dispatcher, and disconnect when the dispatcher is destroyed.
+class COMP_API Dispatcher : public comp::Lockable<comp::mutex>, public comp::DeleteObserver::Notifier
+{
+public:
+    using Clock = comp::chrono::steady_clock;
+    using Invocation = comp::function<void()>;
+
+    /// Constructor.
+    explicit Dispatcher() = default;
+    /// Destructor. Disconnects the queued connections, waits for the invocations they post in
+    /// flight, and drops the pending invocations.
+    ~Dispatcher();
+
+    /// Posts an \a invocation to the dispatcher.
+    /// \param source The source of the invocation, typically the signal that posts it.
+    /// \param priority The priority of the invocation. Invocations with higher priority are
+    ///        dispatched first.
+    /// \param invocation The invocation to post.
+    void post(const void* source, int priority, Invocation invocation);
+
+    /// Dispatches the pending invocations until the queue is drained or the \a budget is spent.
+    /// The invocations not dispatched are carried over to the next dispatch call. The budget is
+    /// checked after each invocation, so at least one invocation is dispatched.
+    /// \param budget The time budget of the dispatch, for example 2 ms for a frame.
+    /// \return The number of invocations dispatched.
+    int dispatch(Clock::duration budget);
+
+    /// Dispatches the pending invocations until the queue is drained.
+    /// \return The number of invocations dispatched.
+    int dispatch();
+
+    /// Returns the number of pending invocations.
+    std::size_t pendingCount();
+
+    /// Posts an \a invocation to the idle queue of the dispatcher. The idle queue is flushed by
+    /// dispatchIdle(), which the owner of the dispatcher calls when its event loop goes idle.
+    /// \param invocation The invocation to post.
+    void postIdle(Invocation invocation);
+
+    /// Flushes the idle queue. The invocations posted to the idle queue while flushing are
+    /// dispatched on the next flush.
+    /// \return The number of invocations dispatched.
+    int dispatchIdle();
+
+    /// Returns the number of invocations pending in the idle queue.
+    std::size_t idleCount();
+
+private:
+    /// Takes the next invocation to dispatch, serving the sources of a priority round-robin.
+    bool takeNext(Invocation& invocation);
+
+    struct Source
+    {
+        const void* id = nullptr;
+        comp::deque<Invocation> invocations;
+    };
+    struct Level
+    {
+        int priority = 0;
+        /// The sources with pending invocations, in the order they are served.
+        comp::deque<Source> sources;
+    };
+    /// The priority levels with pending invocations, ordered from the highest priority.
+    comp::vector<Level> m_levels;
+    std::size_t m_pendingCount = 0u;
+    /// The invocations waiting for the event loop to go idle.
+    comp::deque<Invocation> m_idleInvocations;
+};
+
+} // namespace comp
+
+#endif // COMP_DISPATCHER_HPP
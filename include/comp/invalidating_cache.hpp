@@ -0,0 +1,273 @@
+#ifndef COMP_INVALIDATING_CACHE_HPP
+#define COMP_INVALIDATING_CACHE_HPP
+
+#include <comp/config.hpp>
+#include <comp/signal.hpp>
+#include <comp/wrap/functional.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/optional.hpp>
+#include <comp/wrap/unordered_map.hpp>
+#include <comp/wrap/vector.hpp>
+#include <comp/utility/lockable.hpp>
+#include <comp/utility/tracker.hpp>
+
+namespace comp
+{
+
+/// The %InvalidatingCache holds values computed from keys, and invalidates them when the signals they
+/// depend on are activated. The cache connects a single slot to each dependency signal, which looks up
+/// the affected entries in an index. A keyed dependency signal maps its arguments to a dependency key
+/// with a selector, and invalidates only the entries depending on that key. The invalidated values
+/// are recomputed on the next read.
+/// \tparam Key The key of the cache entries, also the key of the keyed dependencies.
+/// \tparam Value The type of the cached values.
+/// \tparam Hash The hash function of the keys.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class COMP_TEMPLATE_API InvalidatingCache : public comp::Lockable<comp::mutex>, public comp::DeleteObserver
+{
+public:
+    /// The function which computes the value of a key.
+    using Compute = comp::function<Value(const Key&)>;
+
+    /// Constructor, creates a cache which computes its values with the \a compute function.
+    explicit InvalidatingCache(Compute compute)
+        : m_compute(comp::move(compute))
+    {
+    }
+
+    /// Destructor. Unwatches and disconnects from the dependency signals, and waits for the
+    /// invalidations in flight.
+    ~InvalidatingCache()
+    {
+        // Unwatch before the members are destroyed, the deleted dependency signals must not notify
+        // the cache through a destroyed index.
+        stopObserving();
+        auto connections = comp::vector<ConnectionPtr>();
+        {
+            comp::lock_guard lock(*this);
+            for (auto& dependency : m_dependencies)
+            {
+                connections.push_back(dependency.second.connection);
+            }
+        }
+        for (auto& connection : connections)
+        {
+            connection->disconnectAndWait();
+        }
+    }
+
+    /// Returns the value of the \a key. Computes the value if the entry is missing or invalidated.
+    /// The value is computed without holding the cache locked.
+    Value get(const Key& key)
+    {
+        unsigned generation = 0u;
+        {
+            comp::lock_guard lock(*this);
+            auto& entry = m_entries[key];
+            if (entry.value)
+            {
+                return *entry.value;
+            }
+            generation = entry.generation;
+        }
+
+        auto value = m_compute(key);
+
+        comp::lock_guard lock(*this);
+        // Keep the value only if the entry was not invalidated meanwhile.
+        auto& entry = m_entries[key];
+        if (entry.generation == generation)
+        {
+            entry.value = value;
+        }
+        return value;
+    }
+
+    /// Returns whether the cache holds a valid value for the \a key.
+    bool isCached(const Key& key)
+    {
+        comp::lock_guard lock(*this);
+        auto it = m_entries.find(key);
+        return it != m_entries.end() && it->second.value;
+    }
+
+    /// Invalidates the entry of the \a key.
+    void invalidate(const Key& key)
+    {
+        comp::lock_guard lock(*this);
+        invalidateEntry(key);
+    }
+
+    /// Makes the entry of the \a key depend on every activation of the \a signal.
+    /// \param key The key of the entry.
+    /// \param signal The dependency signal.
+    template <typename TRet, typename... TArgs>
+    void dependOn(const Key& key, SignalConceptImpl<TRet, TArgs...>& signal)
+    {
+        comp::lock_guard lock(*this);
+        if (m_dependencies.find(&signal) == m_dependencies.end())
+        {
+            // Connect before indexing the signal, a frozen signal rejects the slot.
+            auto connection = connectSignal(signal, [](TArgs...) { return comp::optional<Key>(); });
+            watch(signal);
+            m_dependencies[&signal].connection = connection;
+        }
+        auto& dependents = m_dependencies[&signal];
+
+        auto& signals = m_entries[key].signals;
+        if (find(signals, &signal) == signals.end())
+        {
+            signals.push_back(&signal);
+            dependents.everyActivation.push_back(key);
+        }
+    }
+
+    /// Makes the \a signal a keyed dependency. The cache maps the arguments of the signal activations
+    /// to a dependency key with the \a selector, and invalidates the entries depending on the key.
+    /// \param signal The dependency signal.
+    /// \param selector The function which takes the arguments of the signal, and returns the
+    ///        dependency key.
+    template <typename TRet, typename... TArgs, class Selector>
+    void track(SignalConceptImpl<TRet, TArgs...>& signal, const Selector& selector)
+    {
+        auto keyed = [selector](TArgs... args)
+        {
+            return comp::optional<Key>(selector(args...));
+        };
+        comp::lock_guard lock(*this);
+        // Connect before indexing the signal, a frozen signal rejects the slot.
+        auto connection = connectSignal(signal, keyed);
+        if (m_dependencies.find(&signal) == m_dependencies.end())
+        {
+            watch(signal);
+        }
+        auto& dependents = m_dependencies[&signal];
+        auto previous = comp::move(dependents.connection);
+        dependents.connection = connection;
+        if (previous)
+        {
+            comp::relock_guard relock(*this);
+            previous->disconnectAndWait();
+        }
+    }
+
+    /// Makes the entry of the \a key depend on the activations of the tracked \a signal with the
+    /// \a dependency key.
+    /// \param key The key of the entry.
+    /// \param signal The dependency signal, tracked with a selector.
+    /// \param dependency The dependency key.
+    /// \throw comp::untracked_signal if the \a signal is not tracked.
+    void dependOn(const Key& key, SignalConcept& signal, const Key& dependency)
+    {
+        comp::lock_guard lock(*this);
+        auto it = m_dependencies.find(&signal);
+        if (it == m_dependencies.end())
+        {
+            throw comp::untracked_signal();
+        }
+
+        auto range = it->second.byDependency.equal_range(dependency);
+        for (auto dependent = range.first; dependent != range.second; ++dependent)
+        {
+            if (dependent->second == key)
+            {
+                return;
+            }
+        }
+        it->second.byDependency.emplace(dependency, key);
+        m_entries[key];
+    }
+
+protected:
+    /// Overrides DeleteObserver::notifyDeleted(), drops the index of the deleted dependency signal.
+    void notifyDeleted(Notifier& object) override
+    {
+        comp::lock_guard lock(*this);
+        auto it = m_dependencies.find(static_cast<SignalConcept*>(&object));
+        if (it == m_dependencies.end())
+        {
+            return;
+        }
+        for (auto& key : it->second.everyActivation)
+        {
+            erase(m_entries[key].signals, it->first);
+        }
+        m_dependencies.erase(it);
+    }
+
+private:
+    struct Entry
+    {
+        comp::optional<Value> value;
+        /// Changes each time the entry is invalidated.
+        unsigned generation = 0u;
+        /// The signals the entry depends on with every activation.
+        comp::vector<SignalConcept*> signals;
+    };
+
+    struct Dependents
+    {
+        ConnectionPtr connection;
+        /// The entries invalidated by every activation of the signal.
+        comp::vector<Key> everyActivation;
+        /// The entries invalidated by the activations with a dependency key.
+        comp::unordered_multimap<Key, Key, Hash> byDependency;
+    };
+
+    // Connects the invalidation slot to the signal. Call it with the cache locked, the signal does
+    // not hold its lock while it activates the slot.
+    template <typename TRet, typename... TArgs, class Selector>
+    ConnectionPtr connectSignal(SignalConceptImpl<TRet, TArgs...>& signal, const Selector& selector)
+    {
+        SignalConcept* source = &signal;
+        auto slot = [this, source, selector](TArgs... args) -> TRet
+        {
+            invalidateDependents(source, selector(args...));
+            if constexpr (!is_void_v<TRet>)
+            {
+                return TRet();
+            }
+        };
+        return signal.connect(slot);
+    }
+
+    void invalidateDependents(SignalConcept* signal, const comp::optional<Key>& dependency)
+    {
+        comp::lock_guard lock(*this);
+        auto it = m_dependencies.find(signal);
+        if (it == m_dependencies.end())
+        {
+            return;
+        }
+        for (auto& key : it->second.everyActivation)
+        {
+            invalidateEntry(key);
+        }
+        if (dependency)
+        {
+            auto range = it->second.byDependency.equal_range(*dependency);
+            for (auto dependent = range.first; dependent != range.second; ++dependent)
+            {
+                invalidateEntry(dependent->second);
+            }
+        }
+    }
+
+    void invalidateEntry(const Key& key)
+    {
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            it->second.value.reset();
+            ++it->second.generation;
+        }
+    }
+
+    Compute m_compute;
+    comp::unordered_map<Key, Entry, Hash> m_entries;
+    comp::unordered_map<SignalConcept*, Dependents> m_dependencies;
+};
+
+} // namespace comp
+
+#endif // COMP_INVALIDATING_CACHE_HPP
@@ -0,0 +1,126 @@
+#ifndef COMP_OBSERVABLE_HPP
+#define COMP_OBSERVABLE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <comp/config.hpp>
+#include <comp/signal.hpp>
+#include <comp/wrap/atomic.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/type_traits.hpp>
+#include <comp/utility/lockable.hpp>
+
+namespace comp
+{
+
+/// The %Observable holds a value, and emits the changed signal when the value is set. Readers get
+/// consistent snapshots of the value without taking locks or writing shared memory: the value is
+/// published under a sequence lock, and readers retry when a writer published meanwhile. Writers
+/// are serialized with a lock that readers never take. The changed signal is emitted by one writer
+/// at a time with the latest value, so the last emission always carries the final value.
+/// \tparam T The type of the value, must be trivially copyable.
+template <typename T>
+class COMP_TEMPLATE_API Observable : public comp::Lockable<comp::mutex>
+{
+    static_assert(is_trivially_copyable_v<T>, "Observable values must be trivially copyable");
+
+    using Word = std::uintptr_t;
+    static constexpr std::size_t WordCount = (sizeof(T) + sizeof(Word) - 1u) / sizeof(Word);
+
+    // The sequence lock and the value share a cache line separate from the writer state.
+    struct alignas(COMP_CACHE_LINE_SIZE) Storage
+    {
+        comp::atomic<unsigned> sequence{0u};
+        comp::atomic<Word> words[WordCount];
+    };
+    Storage m_storage;
+    /// Serializes the emissions of the changed signal.
+    comp::FlagGuard m_notifying;
+    /// Set when a value was published after the last emission took its value.
+    comp::atomic_bool m_notifyPending = false;
+
+    void store(const T& value)
+    {
+        Word words[WordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (auto i = 0u; i < WordCount; ++i)
+        {
+            m_storage.words[i].store(words[i], memory_order_relaxed);
+        }
+    }
+
+public:
+    /// The signal emitted after a new value is published.
+    Signal<void(const T&)> changed;
+
+    /// Constructor, creates an observable with an initial \a value.
+    explicit Observable(const T& value = T())
+    {
+        store(value);
+    }
+
+    /// Returns a consistent snapshot of the value. Does not block, and does not write shared memory.
+    T get() const
+    {
+        Word words[WordCount];
+        while (true)
+        {
+            const auto before = m_storage.sequence.load(memory_order_acquire);
+            if (before & 1u)
+            {
+                // A writer is publishing.
+                continue;
+            }
+            for (auto i = 0u; i < WordCount; ++i)
+            {
+                words[i] = m_storage.words[i].load(memory_order_relaxed);
+            }
+            atomic_thread_fence(memory_order_acquire);
+            if (m_storage.sequence.load(memory_order_relaxed) == before)
+            {
+                break;
+            }
+        }
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    /// Publishes a new \a value, then emits the changed signal with the latest value. When an other
+    /// writer, or a slot of the changed signal on the calling thread, emits the changed signal, the
+    /// emission continues with the latest value after the running one, and set() returns without
+    /// emitting.
+    void set(const T& value)
+    {
+        {
+            comp::lock_guard lock(*this);
+            const auto sequence = m_storage.sequence.load(memory_order_relaxed);
+            m_storage.sequence.store(sequence + 1u, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+            store(value);
+            m_storage.sequence.store(sequence + 2u, memory_order_release);
+        }
+
+        // The emitting writer unlocks before it checks the pending flag, so either this writer
+        // takes the lock, or the emitting writer sees the value pending.
+        m_notifyPending = true;
+        while (m_notifyPending && m_notifying.try_lock())
+        {
+            struct Unlock
+            {
+                comp::FlagGuard& guard;
+                ~Unlock()
+                {
+                    guard.unlock();
+                }
+            } unlock{m_notifying};
+            m_notifyPending = false;
+            changed(get());
+        }
+    }
+};
+
+} // namespace comp
+
+#endif // COMP_OBSERVABLE_HPP
@@ -0,0 +1,338 @@
+#ifndef COMP_SHARDED_SIGNAL_HPP
+#define COMP_SHARDED_SIGNAL_HPP
+
+#include <comp/config.hpp>
+#include <comp/signal.hpp>
+#include <comp/wrap/atomic.hpp>
+#include <comp/wrap/memory.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/thread.hpp>
+#include <comp/utility/lockable.hpp>
+#include <comp/utility/ref_counted.hpp>
+
+namespace comp
+{
+
+/// Returns the shard index of the calling thread. The threads get consecutive indexes in the order
+/// they first ask for one, so the threads of a pool spread evenly on the shards.
+inline unsigned threadShardIndex()
+{
+    static comp::atomic<unsigned> nextIndex{0u};
+    thread_local const unsigned index = nextIndex.fetch_add(1u, memory_order_relaxed);
+    return index;
+}
+
+template <typename TRet, typename... TArgs>
+class ShardedSignal;
+
+/// The %ShardedSignal is a signal for high fan-in activation, which many threads activate concurrently.
+/// Each shard holds a read-only replica of the connections. The activating thread reads the replica
+/// of its shard, so the threads of different shards do not touch the same cache lines on activation.
+///
+/// Connecting and disconnecting slots changes the revision of the signal. The connections invalidated
+/// without disconnecting, like the slots connected once, change the revision on the first activation
+/// that meets them. The shards refresh their replica on the first activation after the revision
+/// changed, and the replaced replicas are released when no activation runs on the shard.
+///
+/// The replicas count the activations of their slots in flight, so the activations do not write the
+/// connection objects shared by the shards. ConnectionConcept::disconnectAndWait() waits for the
+/// activations counted in the replicas.
+///
+/// Unlike the Signal, the threads activate the sharded signal concurrently. The signal only rejects
+/// the re-activation from the thread that already activates it.
+/// \tparam ReturnType The return type of the signal.
+/// \tparam Arguments The arguments of the signal, which is the signature of the signal.
+template <typename ReturnType, typename... Arguments>
+class COMP_TEMPLATE_API ShardedSignal<ReturnType(Arguments...)> : public SignalConceptImpl<ReturnType, Arguments...>
+{
+    using BaseClass = SignalConceptImpl<ReturnType, Arguments...>;
+    using SlotType = typename BaseClass::SlotType;
+    using ConnectionContainer = typename BaseClass::ConnectionContainer;
+
+    // The read-only copy of the connections, published to the shards. The replica counts the
+    // activations in flight of its connections, so the activations do not write the connections.
+    struct Replica
+    {
+        explicit Replica(unsigned revision, const ConnectionContainer& connections)
+            : revision(revision)
+            , connections(connections)
+            , activations(connections.size())
+        {
+        }
+
+        unsigned revision = 0u;
+        ConnectionContainer connections;
+        comp::vector<comp::ref_counter> activations;
+    };
+
+    // Each shard lives on its own cache line, and is written only by the threads of the shard. The
+    // shard lock guards the replica swap, and the replaced replicas.
+    struct alignas(COMP_CACHE_LINE_SIZE) Shard : public comp::Lockable<comp::mutex>
+    {
+        ~Shard()
+        {
+            delete replica.load();
+            releaseRetired();
+        }
+
+        // Releases the replaced replicas. Call it with the shard locked, when no activation runs on
+        // the shard.
+        void releaseRetired()
+        {
+            for (auto previous : retired)
+            {
+                delete previous;
+            }
+            retired.clear();
+            hasRetired = false;
+        }
+
+        comp::atomic<Replica*> replica{nullptr};
+        // The activations in flight on the shard, which may use the replaced replicas.
+        comp::ref_counter activations{0};
+        comp::vector<Replica*> retired;
+        comp::atomic_bool hasRetired{false};
+    };
+
+    // The activations running on the calling thread.
+    struct Activation
+    {
+        const ShardedSignal* signal;
+        Activation* previous;
+    };
+    static inline thread_local Activation* s_activations = nullptr;
+
+    comp::unique_ptr<Shard[]> m_shards;
+    unsigned m_shardCount = 1u;
+
+    bool isActivatedOnThisThread() const
+    {
+        for (auto activation = s_activations; activation; activation = activation->previous)
+        {
+            if (activation->signal == this)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns the replica of the \a shard. Call it with the activation counted on the shard, which
+    // keeps the replica alive. The current replica is checked without locking, the shard is locked
+    // only to refresh a stale replica.
+    Replica* acquireReplica(Shard& shard)
+    {
+        const auto revision = this->m_revision.load(memory_order_acquire);
+        auto current = shard.replica.load(memory_order_acquire);
+        if (current && current->revision == revision)
+        {
+            return current;
+        }
+
+        // Publish the replica with the signal locked, so a disconnectAndWait() which removes a
+        // connection afterwards finds every replica holding the connection.
+        comp::lock_guard lock(*this);
+        this->removeInvalidConnections();
+        auto replica = new Replica(this->m_revision.load(memory_order_relaxed), this->m_connections);
+        comp::lock_guard shardLock(shard);
+        if (auto previous = shard.replica.exchange(replica))
+        {
+            shard.retired.push_back(previous);
+            shard.hasRetired = true;
+        }
+        return replica;
+    }
+
+    static int countActivations(const Replica* replica, const SignalConcept::ConnectionConcept& connection)
+    {
+        if (!replica)
+        {
+            return 0;
+        }
+        int count = 0;
+        for (size_t i = 0u; i < replica->connections.size(); ++i)
+        {
+            if (replica->connections[i].get() == &connection)
+            {
+                count += replica->activations[i];
+            }
+        }
+        return count;
+    }
+
+protected:
+    /// Overrides SignalConcept::waitForSnapshots(), waits for the activations of the \a connection
+    /// running from the replicas.
+    void waitForSnapshots(SignalConcept::ConnectionConcept& connection, int ownActivations) override
+    {
+        auto activations = [this, &connection]()
+        {
+            int count = 0;
+            for (auto i = 0u; i < m_shardCount; ++i)
+            {
+                auto& shard = m_shards[i];
+                comp::lock_guard lock(shard);
+                count += countActivations(shard.replica.load(), connection);
+                for (auto replica : shard.retired)
+                {
+                    count += countActivations(replica, connection);
+                }
+            }
+            return count;
+        };
+#ifdef COMP_CONFIG_THREAD_ENABLED
+        this->waitForActivations([&activations, ownActivations]() { return activations() == ownActivations; });
+#else
+        COMP_ASSERT(activations() == ownActivations);
+#endif
+    }
+
+    /// Overrides SignalConcept::hasSnapshotsBefore(), the replicas may hold the connections of any
+    /// earlier revision while the shards run activations.
+    bool hasSnapshotsBefore(unsigned) override
+    {
+        for (auto i = 0u; i < m_shardCount; ++i)
+        {
+            if (m_shards[i].activations > 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    /// Constructor, creates a sharded signal with \a shardCount shards. The default shard count is
+    /// the number of hardware threads.
+    explicit ShardedSignal(unsigned shardCount = defaultShardCount())
+        : m_shards(new Shard[shardCount > 0u ? shardCount : 1u])
+        , m_shardCount(shardCount > 0u ? shardCount : 1u)
+    {
+    }
+
+    /// Returns the default number of shards.
+    static unsigned defaultShardCount()
+    {
+#ifdef COMP_CONFIG_THREAD_ENABLED
+        return comp::thread::hardware_concurrency();
+#else
+        return 1u;
+#endif
+    }
+
+    /// Returns the number of shards of the signal.
+    unsigned shardCount() const
+    {
+        return m_shardCount;
+    }
+
+    /// Activation override for sharded signals. The operator(), and the signals connected to the
+    /// sharded signal activate the replicas through it.
+    int activate(LastRet<ReturnType>* lastResult, Arguments&&... args) override
+    {
+        if (lastResult)
+        {
+            return emit(*lastResult, comp::forward<Arguments>(args)...);
+        }
+        auto null = NullCollector<ReturnType>();
+        return emit(null, comp::forward<Arguments>(args)...);
+    }
+
+    /// Emit override for sharded signals. Activates the slots of the replica of the shard of the
+    /// calling thread.
+    template <class Collector = NullCollector<ReturnType>>
+    int emit(Collector& collector, Arguments... arguments)
+    {
+        if (this->isBlocked() || isActivatedOnThisThread())
+        {
+            return -1;
+        }
+
+        Activation activation{this, s_activations};
+        s_activations = &activation;
+        struct Restore
+        {
+            Activation& activation;
+            ~Restore()
+            {
+                s_activations = activation.previous;
+            }
+        } restore{activation};
+
+        // The activation counted on the shard keeps the replica alive.
+        auto& shard = m_shards[threadShardIndex() % m_shardCount];
+        ++shard.activations;
+        struct Leave
+        {
+            ShardedSignal& signal;
+            Shard& shard;
+            ~Leave()
+            {
+                if (--shard.activations == 0)
+                {
+                    if (shard.hasRetired)
+                    {
+                        comp::lock_guard lock(shard);
+                        if (shard.activations == 0)
+                        {
+                            shard.releaseRetired();
+                        }
+                    }
+                    signal.releaseRetiredConnections();
+                }
+            }
+        } leave{*this, shard};
+
+        auto replica = acquireReplica(shard);
+        typename BaseClass::SharedArgumentsScope scope;
+        int result = 0;
+        bool stale = false;
+        for (size_t i = 0u; i < replica->connections.size(); ++i)
+        {
+            auto slot = static_cast<SlotType*>(replica->connections[i].get());
+            // Count the activation in the replica before the slot checks its validity, a concurrent
+            // disconnectAndWait() either sees the activation, or the activation sees the connection
+            // invalid.
+            struct Count
+            {
+                comp::ref_counter& activations;
+                ~Count()
+                {
+                    --activations;
+#ifdef COMP_CONFIG_THREAD_ENABLED
+                    BaseClass::notifyActivationDone();
+#endif
+                }
+            } count{replica->activations[i]};
+            ++count.activations;
+            try
+            {
+                if (slot->activateUncounted(collector, comp::forward<Arguments>(arguments)...))
+                {
+                    ++result;
+                }
+            }
+            catch (const comp::bad_slot&)
+            {
+                this->disconnect(*slot);
+            }
+            catch (const comp::bad_weak_ptr&)
+            {
+                this->disconnect(*slot);
+            }
+            // The invalidated connections stay in the container until the next refresh.
+            stale = stale || !slot->isValid();
+        }
+
+        if (stale)
+        {
+            // Change the revision, so the shards drop the invalidated connections from their replica.
+            this->m_revision.fetch_add(1u, memory_order_release);
+        }
+        return result;
+    }
+};
+
+} // namespace comp
+
+#endif // COMP_SHARDED_SIGNAL_HPP
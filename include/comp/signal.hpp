@@ -41,13 +41,6 @@ public:
     {
     }
 
-    /// Activation override for member signals.
-    int operator()(Arguments... args)
-    {
-        auto null = NullCollector<ReturnType>();
-        return this->emit(null, comp::forward<Arguments>(args)...);
-    }
-
     /// Emit override for member signals.
     template <class Collector = NullCollector<ReturnType>>
     int emit(Collector& collector, Arguments... arguments)
@@ -56,6 +49,17 @@ public:
         COMP_ASSERT(lockedHost);
         return BaseClass::emit(collector, comp::forward<Arguments>(arguments)...);
     }
+
+    /// Activation override for member signals, keeps the host alive like emit() does.
+    int activate(LastRet<ReturnType>* lastResult, Arguments&&... args) override
+    {
+        if (lastResult)
+        {
+            return emit(*lastResult, comp::forward<Arguments>(args)...);
+        }
+        auto null = NullCollector<ReturnType>();
+        return emit(null, comp::forward<Arguments>(args)...);
+    }
 };
 
 } // namespace comp
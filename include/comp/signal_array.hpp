@@ -0,0 +1,159 @@
+#ifndef COMP_SIGNAL_ARRAY_HPP
+#define COMP_SIGNAL_ARRAY_HPP
+
+#include <comp/config.hpp>
+#include <comp/signal.hpp>
+#include <comp/wrap/memory.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/unordered_set.hpp>
+#include <comp/wrap/vector.hpp>
+#include <comp/utility/slot_identity.hpp>
+#include <comp/utility/span.hpp>
+
+namespace comp
+{
+
+template <typename Signature>
+class SignalArray;
+
+/// The %SignalArray holds a fixed number of signals with the same signature, like the per-entity
+/// signals of a game world. Use the array to activate a subset of the signals with the same arguments
+/// in one call. The bulk activation takes the slots of all the signals of the subset in one pass, and
+/// activates them with the arguments materialized once.
+/// \tparam ReturnType The return type of the signals.
+/// \tparam Arguments The arguments of the signals, which is the signature of the signals.
+template <typename ReturnType, typename... Arguments>
+class COMP_TEMPLATE_API SignalArray<ReturnType(Arguments...)>
+{
+    using SignalType = Signal<ReturnType(Arguments...)>;
+    using BaseClass = SignalConceptImpl<ReturnType, Arguments...>;
+    using ConnectionContainer = typename BaseClass::ConnectionContainer;
+
+    COMP_DISABLE_COPY_OR_MOVE(SignalArray)
+
+    comp::unique_ptr<SignalType[]> m_signals;
+    size_t m_size;
+
+    // Removes the connections of the slots connected to an earlier signal of the subset. The
+    // \a segments hold the position of the first connection of each signal.
+    static void removeRepeatedSlots(ConnectionContainer& connections, const comp::vector<size_t>& segments)
+    {
+        auto identities = comp::unordered_set<SlotIdentity, SlotIdentity::Hash>();
+        auto segmentIdentities = comp::vector<SlotIdentity>();
+        auto kept = size_t(0u);
+        for (auto segment = 0u; segment < segments.size(); ++segment)
+        {
+            const auto end = segment + 1u < segments.size() ? segments[segment + 1u] : connections.size();
+            for (auto i = segments[segment]; i < end; ++i)
+            {
+                const auto identity = connections[i]->identity();
+                if (!identity.isNull())
+                {
+                    if (identities.count(identity) > 0u)
+                    {
+                        continue;
+                    }
+                    segmentIdentities.push_back(identity);
+                }
+                connections[kept++] = comp::move(connections[i]);
+            }
+            // The slots connected more than once to the same signal are activated with each connection.
+            identities.insert(segmentIdentities.begin(), segmentIdentities.end());
+            segmentIdentities.clear();
+        }
+        connections.resize(kept);
+    }
+
+public:
+    /// Constructor, creates an array of \a size signals.
+    explicit SignalArray(size_t size)
+        : m_signals(new SignalType[size])
+        , m_size(size)
+    {
+    }
+
+    /// Returns the number of signals in the array.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /// Returns the signal at \a index.
+    SignalType& operator[](size_t index)
+    {
+        COMP_ASSERT(index < m_size);
+        return m_signals[index];
+    }
+
+    /// Activates the signals at \a indexes with the same arguments.
+    /// \param indexes The indexes of the signals to activate.
+    /// \param args The arguments to pass to the slots.
+    /// \return The number of slots activated.
+    int emit(comp::span<const size_t> indexes, Arguments... args)
+    {
+        auto null = NullCollector<ReturnType>();
+        return emit(null, indexes, comp::forward<Arguments>(args)...);
+    }
+
+    /// Activates the signals at \a indexes with the same arguments, and collects the results of the
+    /// slots with a \a collector. The signals are activated in the order of the indexes. The blocked
+    /// signals, the signals that are already activated, and the repeated indexes are skipped. A
+    /// function, or a method of a receiver connected to several signals of the subset is activated
+    /// once, with its first connection. Lambdas and functors have no identity, and are activated
+    /// with each connection.
+    /// \param collector The collector which collects the slot results.
+    /// \param indexes The indexes of the signals to activate.
+    /// \param args The arguments to pass to the slots.
+    /// \return The number of slots activated.
+    template <class Collector>
+    int emit(Collector& collector, comp::span<const size_t> indexes, Arguments... args)
+    {
+        // Releases the emit guards taken so far, also when collecting the connections throws.
+        struct Release
+        {
+            comp::vector<BaseClass*> signals;
+            ~Release()
+            {
+                for (auto signal : signals)
+                {
+                    signal->m_emitGuard.unlock();
+                    signal->releaseRetiredConnections();
+                }
+            }
+        } release;
+        release.signals.reserve(indexes.size());
+
+        ConnectionContainer connections;
+        // The position of the first connection of each signal in the connections.
+        comp::vector<size_t> segments;
+        for (auto index : indexes)
+        {
+            COMP_ASSERT(index < m_size);
+            BaseClass& signal = m_signals[index];
+            // The guard of a repeated index is already taken.
+            if (signal.isBlocked() || !signal.m_emitGuard.try_lock())
+            {
+                continue;
+            }
+            // The reserved capacity fits every index, the guard is recorded right after taking it.
+            release.signals.push_back(&signal);
+
+            comp::lock_guard lock(signal);
+            signal.removeInvalidConnections();
+            signal.m_snapshotRevision = signal.m_revision.load(memory_order_relaxed);
+            segments.push_back(connections.size());
+            connections.insert(connections.end(), signal.m_connections.begin(), signal.m_connections.end());
+        }
+
+        if (segments.size() > 1u)
+        {
+            removeRepeatedSlots(connections, segments);
+        }
+
+        return BaseClass::activateSlots(connections, collector, comp::forward<Arguments>(args)...);
+    }
+};
+
+} // namespace comp
+
+#endif // COMP_SIGNAL_ARRAY_HPP
@@ -0,0 +1,150 @@
+#ifndef COMP_SIGNAL_STREAM_HPP
+#define COMP_SIGNAL_STREAM_HPP
+
+#include <comp/config.hpp>
+#include <comp/concept/signal.hpp>
+#include <comp/concept/signal_impl.hpp>
+#include <comp/wrap/algorithm.hpp>
+#include <comp/wrap/chrono.hpp>
+#include <comp/wrap/condition_variable.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/tuple.hpp>
+#include <comp/wrap/type_traits.hpp>
+#include <comp/wrap/utility.hpp>
+#include <comp/wrap/vector.hpp>
+#include <comp/utility/lockable.hpp>
+#include <comp/utility/span.hpp>
+
+namespace comp
+{
+
+template <typename TRet, typename... TArgs>
+class SignalStream;
+
+/// The %SignalStream subscribes to a signal, and buffers the arguments of the signal activations in
+/// a fixed capacity ring. The consumers pull the buffered activations in batches, at their own pace,
+/// and on their own thread. When the ring is full, the stream drops the new activations, and counts
+/// them.
+///
+/// The elements of the stream are the arguments of the signal. Signals with one argument stream the
+/// decayed argument, signals with more arguments stream a tuple of the decayed arguments. The element
+/// type must be default constructible.
+/// \tparam ReturnType The return type of the signal. The slot of the stream returns a default
+///         constructed value.
+/// \tparam Arguments The arguments of the signal.
+template <typename ReturnType, typename... Arguments>
+class COMP_TEMPLATE_API SignalStream<ReturnType(Arguments...)> : public comp::Lockable<comp::mutex>
+{
+    COMP_DISABLE_COPY_OR_MOVE(SignalStream)
+
+public:
+    /// The element type of the stream.
+    using Element = StoredArguments<Arguments...>;
+
+    /// Constructor, subscribes to a \a signal, and buffers at most \a capacity activations.
+    explicit SignalStream(SignalConceptImpl<ReturnType, Arguments...>& signal, size_t capacity)
+        : m_buffer(capacity > 0u ? capacity : 1u)
+    {
+        auto slot = [this](Arguments... args) -> ReturnType
+        {
+            push(args...);
+            if constexpr (!is_void_v<ReturnType>)
+            {
+                return ReturnType();
+            }
+        };
+        m_connection = signal.connect(slot);
+    }
+
+    /// Destructor, unsubscribes from the signal, and waits for the activation in flight to complete.
+    ~SignalStream()
+    {
+        m_connection->disconnectAndWait();
+    }
+
+    /// Returns the number of activations the stream buffers.
+    size_t capacity() const
+    {
+        return m_buffer.size();
+    }
+
+    /// Returns the number of activations buffered.
+    size_t size()
+    {
+        comp::lock_guard lock(*this);
+        return m_size;
+    }
+
+    /// Returns the number of activations dropped because the ring was full.
+    size_t droppedCount()
+    {
+        comp::lock_guard lock(*this);
+        return m_droppedCount;
+    }
+
+    /// Moves the oldest buffered activations to the \a output span, in the order of the activation.
+    /// \param output The span to read the activations into.
+    /// \return The number of activations read.
+    size_t read(comp::span<Element> output)
+    {
+        comp::lock_guard lock(*this);
+        const auto count = output.size() < m_size ? output.size() : m_size;
+        for (auto i = 0u; i < count; ++i)
+        {
+            output[i] = comp::move(m_buffer[m_head]);
+            m_head = (m_head + 1u) % m_buffer.size();
+        }
+        m_size -= count;
+        return count;
+    }
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    /// Blocks the calling thread until at least \a count activations are buffered, or the \a timeout
+    /// elapses. The stream wakes up the consumer only once the batch is complete.
+    /// \return If the batch is complete, returns \e true, otherwise \e false.
+    bool waitFor(size_t count, comp::chrono::nanoseconds timeout)
+    {
+        count = count < m_buffer.size() ? count : m_buffer.size();
+        comp::unique_lock lock(*this);
+        // Each consumer registers its own batch size, the stream wakes up the consumers when the
+        // buffered activations reach any of them.
+        m_wakeupSizes.push_back(count);
+        const auto ready = m_condition.wait_for(lock, timeout, [this, count]() { return m_size >= count; });
+        m_wakeupSizes.erase(comp::find(m_wakeupSizes.begin(), m_wakeupSizes.end(), count));
+        return ready;
+    }
+#endif
+
+private:
+    void push(Arguments&... args)
+    {
+        comp::lock_guard lock(*this);
+        if (m_size == m_buffer.size())
+        {
+            ++m_droppedCount;
+            return;
+        }
+        m_buffer[(m_head + m_size) % m_buffer.size()] = Element(args...);
+        ++m_size;
+#ifdef COMP_CONFIG_THREAD_ENABLED
+        if (comp::find(m_wakeupSizes.begin(), m_wakeupSizes.end(), m_size) != m_wakeupSizes.end())
+        {
+            m_condition.notify_all();
+        }
+#endif
+    }
+
+    comp::vector<Element> m_buffer;
+    ConnectionPtr m_connection;
+    size_t m_head = 0u;
+    size_t m_size = 0u;
+    size_t m_droppedCount = 0u;
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    comp::condition_variable_any m_condition;
+    comp::vector<size_t> m_wakeupSizes;
+#endif
+};
+
+} // namespace comp
+
+#endif // COMP_SIGNAL_STREAM_HPP
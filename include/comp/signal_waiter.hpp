@@ -0,0 +1,376 @@
+#ifndef COMP_SIGNAL_WAITER_HPP
+#define COMP_SIGNAL_WAITER_HPP
+
+#include <comp/config.hpp>
+#include <comp/concept/signal.hpp>
+#include <comp/wrap/atomic.hpp>
+#include <comp/wrap/chrono.hpp>
+#include <comp/wrap/condition_variable.hpp>
+#include <comp/wrap/mutex.hpp>
+#include <comp/wrap/optional.hpp>
+#include <comp/wrap/tuple.hpp>
+#include <comp/wrap/type_traits.hpp>
+#include <comp/wrap/utility.hpp>
+#include <comp/wrap/variant.hpp>
+#include <comp/wrap/vector.hpp>
+#include <comp/utility/lockable.hpp>
+#include <comp/utility/ref_counted.hpp>
+
+namespace comp
+{
+
+/// The base of the signal waiters. The waiter gets ready when the signals it waits for are activated.
+class COMP_API SignalWaiter : public comp::Lockable<comp::mutex>
+{
+public:
+    /// Returns whether the signals the waiter waits for were activated.
+    bool isReady() const;
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    /// Blocks the calling thread until the waiter gets ready.
+    void wait();
+
+    /// Blocks the calling thread until the waiter gets ready, or the \a timeout elapses.
+    /// \return If the waiter got ready, returns \e true, otherwise \e false.
+    bool waitFor(comp::chrono::nanoseconds timeout);
+#endif
+
+protected:
+    /// Constructor.
+    explicit SignalWaiter() = default;
+
+    /// Marks the waiter ready, and wakes up the threads that wait for it. Call it with the waiter
+    /// locked.
+    void setReady();
+
+private:
+    comp::atomic_bool m_isReady = false;
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    comp::condition_variable_any m_condition;
+#endif
+};
+
+namespace
+{
+
+// The temporary slot of a waiter. The slot copies the signal arguments, and passes them to the waiter.
+template <class Waiter, size_t Index, typename TRet, typename... TArgs>
+class WaitConnection final : public SignalConceptImpl<TRet, TArgs...>::SlotType
+{
+    Waiter* m_waiter;
+
+public:
+    explicit WaitConnection(SignalConcept& signal, Waiter& waiter)
+        : SignalConceptImpl<TRet, TArgs...>::SlotType(signal)
+        , m_waiter(&waiter)
+    {
+    }
+
+    size_t objectSize() const override
+    {
+        return sizeof(*this);
+    }
+
+    // Detaches the slot from the waiter, and disconnects it. Waits for the running activation of the
+    // slot to complete. Call it without the waiter locked.
+    void detach()
+    {
+        {
+            comp::lock_guard lock(*this);
+            m_waiter = nullptr;
+        }
+        this->disconnect();
+    }
+
+protected:
+    TRet activateOverride(TArgs&&... args) override
+    {
+        // The waiter returns the slots it no longer needs, disconnect them with the locks released.
+        auto cancelled = comp::vector<ConnectionPtr>();
+        {
+            comp::lock_guard lock(*this);
+            if (m_waiter)
+            {
+                cancelled = m_waiter->template deliver<Index>(comp::tuple<decay_t<TArgs>...>(args...));
+            }
+        }
+        for (auto& connection : cancelled)
+        {
+            connection->disconnect();
+        }
+        if constexpr (!is_void_v<TRet>)
+        {
+            return TRet();
+        }
+    }
+};
+
+template <typename TRet, typename... TArgs>
+SignalConceptImpl<TRet, TArgs...> signalConceptOf(const SignalConceptImpl<TRet, TArgs...>&);
+
+template <class SignalConceptType>
+struct WaitTraits;
+
+template <typename TRet, typename... TArgs>
+struct WaitTraits<SignalConceptImpl<TRet, TArgs...>>
+{
+    using Arguments = comp::tuple<decay_t<TArgs>...>;
+
+    template <class Waiter, size_t Index>
+    using Connection = WaitConnection<Waiter, Index, TRet, TArgs...>;
+};
+
+template <class SignalType>
+using SignalWaitTraits = WaitTraits<decltype(signalConceptOf(comp::declval<SignalType&>()))>;
+
+}
+
+/// The %WhenAny waits for the first activation of any of a set of signals. The waiter connects a
+/// temporary slot to each signal, which copies the arguments of the activation. When one of the signals
+/// is activated, the waiter gets ready, and the temporary slots are disconnected from the signals.
+/// \tparam Signals The signals the waiter waits for.
+template <class... Signals>
+class COMP_TEMPLATE_API WhenAny : public SignalWaiter
+{
+    template <class, size_t, typename, typename...>
+    friend class WaitConnection;
+
+    template <size_t Index>
+    using SignalType = typename comp::tuple_element<Index, comp::tuple<Signals...>>::type;
+    template <size_t Index>
+    using Connection = typename SignalWaitTraits<SignalType<Index>>::template Connection<WhenAny, Index>;
+
+    COMP_DISABLE_COPY_OR_MOVE(WhenAny)
+
+public:
+    /// The result of the waiter, holds the arguments of the signal activated.
+    using Result = comp::variant<typename SignalWaitTraits<Signals>::Arguments...>;
+
+    /// Constructor, waits for any of the \a signals.
+    explicit WhenAny(Signals&... signals)
+        : WhenAny(index_sequence_for<Signals...>(), signals...)
+    {
+    }
+
+    /// Destructor, detaches the temporary slots from the waiter.
+    ~WhenAny()
+    {
+        detachAll();
+    }
+
+    /// Returns the index of the signal activated. Call it when the waiter is ready.
+    size_t index() const
+    {
+        COMP_ASSERT(isReady());
+        return m_result->index();
+    }
+
+    /// Returns the result of the waiter. Call it when the waiter is ready.
+    const Result& result() const
+    {
+        COMP_ASSERT(isReady());
+        return *m_result;
+    }
+
+    /// Returns the arguments of the signal at \a Index. Call it when the waiter is ready, and the
+    /// signal at \a Index was activated.
+    template <size_t Index>
+    const auto& get() const
+    {
+        return comp::get<Index>(result());
+    }
+
+private:
+    template <size_t... Indexes>
+    explicit WhenAny(index_sequence<Indexes...>, Signals&... signals)
+    {
+        // The destructor does not run when a signal rejects the slot, detach the attached slots.
+        try
+        {
+            (attach<Indexes>(signals), ...);
+        }
+        catch (...)
+        {
+            detachAll();
+            throw;
+        }
+    }
+
+    void detachAll()
+    {
+        auto detach = [](auto&... connections)
+        {
+            ((connections ? connections->detach() : void()), ...);
+        };
+        comp::apply(detach, m_connections);
+    }
+
+    template <size_t Index>
+    void attach(SignalType<Index>& signal)
+    {
+        auto connection = comp::make_intrusive<Connection<Index>>(signal, *this);
+        {
+            comp::lock_guard lock(*this);
+            comp::get<Index>(m_connections) = connection;
+            if (m_result)
+            {
+                return;
+            }
+        }
+        signal.addConnection(connection);
+    }
+
+    // Returns the slots to disconnect.
+    template <size_t Index, class Arguments>
+    comp::vector<ConnectionPtr> deliver(Arguments&& arguments)
+    {
+        auto cancelled = comp::vector<ConnectionPtr>();
+        comp::lock_guard lock(*this);
+        if (m_result)
+        {
+            return cancelled;
+        }
+        m_result.emplace(in_place_index<Index>, comp::forward<Arguments>(arguments));
+
+        auto cancel = [&cancelled](auto&... connections)
+        {
+            ((connections ? cancelled.push_back(connections) : void()), ...);
+        };
+        comp::apply(cancel, m_connections);
+        setReady();
+        return cancelled;
+    }
+
+    template <size_t... Indexes>
+    static auto connectionsOf(index_sequence<Indexes...>) -> comp::tuple<comp::intrusive_ptr<Connection<Indexes>>...>;
+
+    comp::optional<Result> m_result;
+    decltype(connectionsOf(index_sequence_for<Signals...>())) m_connections;
+};
+
+/// The %WhenAll waits for the activation of all the signals of a set. The waiter connects a temporary
+/// slot to each signal, which copies the arguments of the first activation of the signal, and is
+/// disconnected right after. The waiter gets ready when each signal was activated.
+/// \tparam Signals The signals the waiter waits for.
+template <class... Signals>
+class COMP_TEMPLATE_API WhenAll : public SignalWaiter
+{
+    template <class, size_t, typename, typename...>
+    friend class WaitConnection;
+
+    template <size_t Index>
+    using SignalType = typename comp::tuple_element<Index, comp::tuple<Signals...>>::type;
+    template <size_t Index>
+    using Connection = typename SignalWaitTraits<SignalType<Index>>::template Connection<WhenAll, Index>;
+
+    COMP_DISABLE_COPY_OR_MOVE(WhenAll)
+
+public:
+    /// Constructor, waits for all the \a signals.
+    explicit WhenAll(Signals&... signals)
+        : WhenAll(index_sequence_for<Signals...>(), signals...)
+    {
+    }
+
+    /// Destructor, detaches the temporary slots from the waiter.
+    ~WhenAll()
+    {
+        detachAll();
+    }
+
+    /// Returns the arguments of the signal at \a Index. Call it when the signal at \a Index was
+    /// activated.
+    template <size_t Index>
+    const auto& get() const
+    {
+        COMP_ASSERT(comp::get<Index>(m_results));
+        return *comp::get<Index>(m_results);
+    }
+
+private:
+    template <size_t... Indexes>
+    explicit WhenAll(index_sequence<Indexes...>, Signals&... signals)
+    {
+        // The destructor does not run when a signal rejects the slot, detach the attached slots.
+        try
+        {
+            (attach<Indexes>(signals), ...);
+        }
+        catch (...)
+        {
+            detachAll();
+            throw;
+        }
+    }
+
+    void detachAll()
+    {
+        auto detach = [](auto&... connections)
+        {
+            ((connections ? connections->detach() : void()), ...);
+        };
+        comp::apply(detach, m_connections);
+    }
+
+    template <size_t Index>
+    void attach(SignalType<Index>& signal)
+    {
+        auto connection = comp::make_intrusive<Connection<Index>>(signal, *this);
+        {
+            comp::lock_guard lock(*this);
+            comp::get<Index>(m_connections) = connection;
+        }
+        signal.addConnection(connection);
+    }
+
+    // Returns the slots to disconnect.
+    template <size_t Index, class Arguments>
+    comp::vector<ConnectionPtr> deliver(Arguments&& arguments)
+    {
+        comp::lock_guard lock(*this);
+        auto& result = comp::get<Index>(m_results);
+        if (result)
+        {
+            return {};
+        }
+        result.emplace(comp::forward<Arguments>(arguments));
+
+        auto isComplete = [](const auto&... results)
+        {
+            return (static_cast<bool>(results) && ...);
+        };
+        if (comp::apply(isComplete, m_results))
+        {
+            setReady();
+        }
+        return {comp::get<Index>(m_connections)};
+    }
+
+    template <size_t... Indexes>
+    static auto connectionsOf(index_sequence<Indexes...>) -> comp::tuple<comp::intrusive_ptr<Connection<Indexes>>...>;
+
+    comp::tuple<comp::optional<typename SignalWaitTraits<Signals>::Arguments>...> m_results;
+    decltype(connectionsOf(index_sequence_for<Signals...>())) m_connections;
+};
+
+/// Creates a waiter that waits for the first activation of any of the \a signals.
+/// \param signals The signals to wait for.
+/// \return The waiter.
+template <class... Signals>
+WhenAny<Signals...> when_any(Signals&... signals)
+{
+    return WhenAny<Signals...>(signals...);
+}
+
+/// Creates a waiter that waits for the activation of all the \a signals.
+/// \param signals The signals to wait for.
+/// \return The waiter.
+template <class... Signals>
+WhenAll<Signals...> when_all(Signals&... signals)
+{
+    return WhenAll<Signals...>(signals...);
+}
+
+} // namespace comp
+
+#endif // COMP_SIGNAL_WAITER_HPP
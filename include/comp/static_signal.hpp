@@ -0,0 +1,99 @@
+#ifndef COMP_STATIC_SIGNAL_HPP
+#define COMP_STATIC_SIGNAL_HPP
+
+#include <comp/config.hpp>
+#include <comp/signal.hpp>
+#include <comp/wrap/atomic.hpp>
+#include <comp/wrap/utility.hpp>
+
+namespace comp
+{
+
+template <typename Signature>
+class StaticSignal;
+
+/// The %StaticSignal is a signal for global and function-static declarations. The static signal has
+/// a constexpr constructor, so it is initialized at compile time, and allocates the signal on the
+/// first connect. Activating a static signal without slots does not allocate. Declare the static
+/// signals with COMP_CONSTINIT to have the compiler check the constant initialization.
+/// \tparam TRet The return type of the signal.
+/// \tparam TArgs The arguments of the signal.
+template <typename TRet, typename... TArgs>
+class COMP_TEMPLATE_API StaticSignal<TRet(TArgs...)>
+{
+    COMP_DISABLE_COPY_OR_MOVE(StaticSignal)
+
+public:
+    using SignalType = Signal<TRet(TArgs...)>;
+
+    /// Constructor. Does not allocate.
+    constexpr StaticSignal() noexcept = default;
+
+    /// Destructor, destroys the signal.
+    ~StaticSignal()
+    {
+        delete m_signal.exchange(nullptr);
+    }
+
+    /// Returns the signal, and allocates it on the first call.
+    SignalType& signal()
+    {
+        auto signal = m_signal.load(memory_order_acquire);
+        if (!signal)
+        {
+            // The concurrent callers race to install the signal, the losers destroy theirs.
+            auto created = new SignalType;
+            if (m_signal.compare_exchange_strong(signal, created, memory_order_acq_rel))
+            {
+                signal = created;
+            }
+            else
+            {
+                delete created;
+            }
+        }
+        return *signal;
+    }
+
+    /// Returns whether the signal is allocated.
+    bool isAllocated() const
+    {
+        return m_signal.load(memory_order_acquire) != nullptr;
+    }
+
+    /// Connects a slot to the signal. Takes the arguments of the connect() overloads of the signal.
+    /// \return Returns the pointer to the connection.
+    template <typename... Arguments>
+    ConnectionPtr connect(Arguments&&... arguments)
+    {
+        return signal().connect(comp::forward<Arguments>(arguments)...);
+    }
+
+    /// Activates the signal.
+    /// \param args The arguments to pass to the slots.
+    /// \return The number of connections activated. The signal which is not allocated activates no
+    ///         slots, and returns 0.
+    int operator()(TArgs... args)
+    {
+        auto signal = m_signal.load(memory_order_acquire);
+        return signal ? (*signal)(comp::forward<TArgs>(args)...) : 0;
+    }
+
+    /// Activates the signal with a \a collector.
+    /// \param collector The collector which collects the slot results.
+    /// \param args The arguments to pass to the slots.
+    /// \return The number of connections activated, or -1 if the signal is blocked, or re-activated.
+    template <class Collector = NullCollector<TRet>>
+    int emit(Collector& collector, TArgs... args)
+    {
+        auto signal = m_signal.load(memory_order_acquire);
+        return signal ? signal->emit(collector, comp::forward<TArgs>(args)...) : 0;
+    }
+
+private:
+    comp::atomic<SignalType*> m_signal{nullptr};
+};
+
+} // namespace comp
+
+#endif // COMP_STATIC_SIGNAL_HPP
@@ -0,0 +1,66 @@
+#ifndef COMP_MEMORY_USAGE_HPP
+#define COMP_MEMORY_USAGE_HPP
+
+#include <cstddef>
+#include <comp/config.hpp>
+
+namespace comp
+{
+
+/// The slot classes of the memory usage report.
+enum class SlotClass : unsigned char
+{
+    /// Function, functor and lambda slots, including the slots activated once and the tracked slots.
+    Function,
+    /// Method slots.
+    Method,
+    /// Signal slots, which connect a signal to an other signal.
+    Signal,
+    /// Queued and coalesced slots.
+    Queued,
+    /// The other slots, like the temporary slots of the signal waiters.
+    Other,
+    /// The number of slot classes.
+    Count
+};
+
+/// The memory usage report, the bytes held by the signals and their slots.
+struct COMP_API MemoryUsage
+{
+    static constexpr std::size_t SlotClassCount = static_cast<std::size_t>(SlotClass::Count);
+
+    /// The bytes held by the connection containers and the slot identity indexes.
+    std::size_t containers = 0u;
+    /// The bytes held by the observer lists of the signals and the slots.
+    std::size_t observers = 0u;
+    /// The bytes held by the slot objects, including the callables stored in them, per slot class.
+    std::size_t slotBytes[SlotClassCount] = {};
+    /// The number of slots per slot class.
+    std::size_t slotCount[SlotClassCount] = {};
+
+    /// Returns the bytes held by the slot objects of all classes.
+    std::size_t slots() const
+    {
+        auto bytes = std::size_t(0u);
+        for (auto classBytes : slotBytes)
+        {
+            bytes += classBytes;
+        }
+        return bytes;
+    }
+
+    /// Returns the total bytes of the report.
+    std::size_t total() const
+    {
+        return containers + observers + slots();
+    }
+};
+
+/// Returns the memory used by the slots connected to signals, per slot class. The slots are counted
+/// from the time they are connected to a signal until they are destroyed. The memory held by the
+/// containers and the observer lists is reported per signal, see SignalConcept::memoryUsage().
+COMP_API MemoryUsage memoryUsage();
+
+} // namespace comp
+
+#endif // COMP_MEMORY_USAGE_HPP
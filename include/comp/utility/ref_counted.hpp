@@ -0,0 +1,260 @@
+#ifndef COMP_REF_COUNTED_HPP
+#define COMP_REF_COUNTED_HPP
+
+#include <cstddef>
+#include <comp/config.hpp>
+#include <comp/wrap/algorithm.hpp>
+#include <comp/wrap/atomic.hpp>
+#include <comp/wrap/type_traits.hpp>
+#include <comp/wrap/utility.hpp>
+
+namespace comp
+{
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+/// The reference counter type. Thread-safe builds count references atomically.
+using ref_counter = atomic_int;
+#else
+/// The reference counter type. Single-threaded builds count references with a plain integer.
+using ref_counter = int;
+#endif
+
+/// Implements an intrusive reference counted object. The reference count lives in the object,
+/// so the object and its count share a single allocation. The object deletes itself when the last
+/// reference is released.
+/// \tparam CounterType The type of the reference counter, a plain or an atomic integer.
+template <typename CounterType = ref_counter>
+class COMP_TEMPLATE_API RefCounted
+{
+    CounterType m_refCount{0};
+
+    COMP_DISABLE_COPY_OR_MOVE(RefCounted)
+
+public:
+    explicit RefCounted() = default;
+    virtual ~RefCounted() = default;
+
+    /// Adds a reference to the object.
+    void retain()
+    {
+        if constexpr (is_same_v<CounterType, atomic_int>)
+        {
+            m_refCount.fetch_add(1, memory_order_relaxed);
+        }
+        else
+        {
+            ++m_refCount;
+        }
+    }
+
+    /// Adds a reference to the object, unless the last reference was released, and the object is
+    /// being deleted.
+    /// \return If the reference was added, returns \e true, otherwise \e false.
+    bool tryRetain()
+    {
+        if constexpr (is_same_v<CounterType, atomic_int>)
+        {
+            auto count = m_refCount.load(memory_order_relaxed);
+            while (count > 0)
+            {
+                if (m_refCount.compare_exchange_weak(count, count + 1, memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        else
+        {
+            if (m_refCount == 0)
+            {
+                return false;
+            }
+            ++m_refCount;
+            return true;
+        }
+    }
+
+    /// Releases a reference to the object. Deletes the object when the last reference is released.
+    void release()
+    {
+        if constexpr (is_same_v<CounterType, atomic_int>)
+        {
+            if (m_refCount.fetch_sub(1, memory_order_acq_rel) == 1)
+            {
+                delete this;
+            }
+        }
+        else
+        {
+            if (--m_refCount == 0)
+            {
+                delete this;
+            }
+        }
+    }
+
+    /// Returns the number of references held on the object.
+    int useCount() const
+    {
+        return m_refCount;
+    }
+};
+
+/// Smart pointer to an intrusive reference counted object. The pointed type must provide retain()
+/// and release() methods, as RefCounted does.
+/// \tparam T The type of the object pointed.
+template <class T>
+class COMP_TEMPLATE_API intrusive_ptr
+{
+    template <class U>
+    friend class intrusive_ptr;
+
+    T* m_ptr = nullptr;
+
+public:
+    using element_type = T;
+
+    /// Creates a null pointer.
+    constexpr intrusive_ptr() noexcept = default;
+    constexpr intrusive_ptr(std::nullptr_t) noexcept
+    {
+    }
+
+    /// Creates a pointer to \a ptr, and adds a reference to it.
+    explicit intrusive_ptr(T* ptr)
+        : m_ptr(ptr)
+    {
+        if (m_ptr)
+        {
+            m_ptr->retain();
+        }
+    }
+
+    /// Creates a pointer to \a ptr. If \a addRef is \e false, adopts a reference already added.
+    explicit intrusive_ptr(T* ptr, bool addRef)
+        : m_ptr(ptr)
+    {
+        if (m_ptr && addRef)
+        {
+            m_ptr->retain();
+        }
+    }
+
+    intrusive_ptr(const intrusive_ptr& other)
+        : intrusive_ptr(other.m_ptr)
+    {
+    }
+    template <class U, typename = enable_if_t<is_convertible_v<U*, T*>>>
+    intrusive_ptr(const intrusive_ptr<U>& other)
+        : intrusive_ptr(static_cast<T*>(other.m_ptr))
+    {
+    }
+
+    intrusive_ptr(intrusive_ptr&& other) noexcept
+        : m_ptr(exchange(other.m_ptr, nullptr))
+    {
+    }
+    template <class U, typename = enable_if_t<is_convertible_v<U*, T*>>>
+    intrusive_ptr(intrusive_ptr<U>&& other) noexcept
+        : m_ptr(exchange(other.m_ptr, nullptr))
+    {
+    }
+
+    ~intrusive_ptr()
+    {
+        if (m_ptr)
+        {
+            m_ptr->release();
+        }
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& other)
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+    intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+    {
+        intrusive_ptr(comp::move(other)).swap(*this);
+        return *this;
+    }
+
+    /// Releases the pointed object.
+    void reset()
+    {
+        intrusive_ptr().swap(*this);
+    }
+
+    void swap(intrusive_ptr& other) noexcept
+    {
+        comp::swap(m_ptr, other.m_ptr);
+    }
+
+    T* get() const
+    {
+        return m_ptr;
+    }
+    T& operator*() const
+    {
+        return *m_ptr;
+    }
+    T* operator->() const
+    {
+        return m_ptr;
+    }
+    explicit operator bool() const
+    {
+        return m_ptr != nullptr;
+    }
+
+    /// Returns the number of references held on the pointed object.
+    int use_count() const
+    {
+        return m_ptr ? m_ptr->useCount() : 0;
+    }
+};
+
+template <class T, class U>
+bool operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs)
+{
+    return lhs.get() == rhs.get();
+}
+template <class T, class U>
+bool operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs)
+{
+    return lhs.get() != rhs.get();
+}
+template <class T>
+bool operator==(const intrusive_ptr<T>& lhs, std::nullptr_t)
+{
+    return !lhs;
+}
+template <class T>
+bool operator!=(const intrusive_ptr<T>& lhs, std::nullptr_t)
+{
+    return static_cast<bool>(lhs);
+}
+
+/// Creates an intrusive reference counted object in a single allocation.
+template <class T, class... Arguments>
+intrusive_ptr<T> make_intrusive(Arguments&&... args)
+{
+    return intrusive_ptr<T>(new T(forward<Arguments>(args)...));
+}
+
+template <class T, class U>
+intrusive_ptr<T> static_pointer_cast(const intrusive_ptr<U>& ptr)
+{
+    return intrusive_ptr<T>(static_cast<T*>(ptr.get()));
+}
+
+template <class T, class U>
+intrusive_ptr<T> dynamic_pointer_cast(const intrusive_ptr<U>& ptr)
+{
+    return intrusive_ptr<T>(dynamic_cast<T*>(ptr.get()));
+}
+
+} // namespace comp
+
+#endif // COMP_REF_COUNTED_HPP
@@ -0,0 +1,80 @@
+#ifndef COMP_SLOT_IDENTITY_HPP
+#define COMP_SLOT_IDENTITY_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <comp/config.hpp>
+#include <comp/wrap/type_traits.hpp>
+
+namespace comp
+{
+
+/// The %SlotIdentity identifies the callable of a slot: a function pointer, a receiver object with
+/// a method pointer, or a receiver signal. Lambdas and functors have no identity.
+class COMP_API SlotIdentity
+{
+    // Method pointers take two pointers on the supported platforms.
+    static constexpr std::size_t CallableSize = 2 * sizeof(void*);
+
+    const void* m_receiver = nullptr;
+    alignas(void*) unsigned char m_callable[CallableSize] = {};
+
+public:
+    /// Hash function object, to use the identity as a key in unordered containers.
+    struct Hash
+    {
+        std::size_t operator()(const SlotIdentity& identity) const
+        {
+            return identity.hash();
+        }
+    };
+
+    /// Creates a null identity.
+    explicit SlotIdentity() = default;
+
+    /// Creates the identity of a \a function pointer.
+    template <typename Function>
+    static SlotIdentity function(Function function)
+    {
+        static_assert(is_pointer_v<Function> && is_function_v<remove_pointer_t<Function>>, "not a function pointer");
+        auto identity = SlotIdentity();
+        std::memcpy(identity.m_callable, &function, sizeof(Function));
+        return identity;
+    }
+
+    /// Creates the identity of a \a method invoked on a \a receiver object.
+    template <typename Method>
+    static SlotIdentity method(const void* receiver, Method method)
+    {
+        static_assert(is_member_function_pointer_v<Method>, "not a method pointer");
+        static_assert(sizeof(Method) <= CallableSize, "method pointer too large");
+        auto identity = SlotIdentity();
+        identity.m_receiver = receiver;
+        std::memcpy(identity.m_callable, &method, sizeof(Method));
+        return identity;
+    }
+
+    /// Creates the identity of a \a receiver object that has no callable, like a receiver signal.
+    static SlotIdentity receiver(const void* receiver)
+    {
+        auto identity = SlotIdentity();
+        identity.m_receiver = receiver;
+        return identity;
+    }
+
+    /// Returns whether the identity is null.
+    bool isNull() const;
+
+    /// Returns the hash of the identity.
+    std::size_t hash() const;
+
+    bool operator==(const SlotIdentity& other) const;
+    bool operator!=(const SlotIdentity& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+} // namespace comp
+
+#endif // COMP_SLOT_IDENTITY_HPP
@@ -0,0 +1,99 @@
+#ifndef COMP_SPAN_HPP
+#define COMP_SPAN_HPP
+
+#include <cstddef>
+#include <comp/config.hpp>
+#include <comp/wrap/type_traits.hpp>
+#include <comp/wrap/vector.hpp>
+
+namespace comp
+{
+
+/// A non-owning view on a contiguous sequence of elements, a subset of the C++20 std::span.
+/// \tparam T The element type.
+template <typename T>
+class COMP_TEMPLATE_API span
+{
+    T* m_data = nullptr;
+    std::size_t m_size = 0u;
+
+public:
+    using element_type = T;
+    using value_type = remove_cv_t<T>;
+    using size_type = std::size_t;
+    using iterator = T*;
+
+    /// Creates an empty span.
+    constexpr span() noexcept = default;
+
+    /// Creates a span on \a size elements from \a data.
+    constexpr span(T* data, size_type size) noexcept
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    /// Creates a span on an \a array.
+    template <std::size_t N>
+    constexpr span(T (&array)[N]) noexcept
+        : m_data(array)
+        , m_size(N)
+    {
+    }
+
+    /// Creates a span on the elements of a \a vector.
+    template <typename Allocator>
+    span(vector<value_type, Allocator>& vector) noexcept
+        : m_data(vector.data())
+        , m_size(vector.size())
+    {
+    }
+    template <typename Allocator, typename U = T, typename = enable_if_t<is_const_v<U>>>
+    span(const vector<value_type, Allocator>& vector) noexcept
+        : m_data(vector.data())
+        , m_size(vector.size())
+    {
+    }
+
+    constexpr T* data() const noexcept
+    {
+        return m_data;
+    }
+    constexpr size_type size() const noexcept
+    {
+        return m_size;
+    }
+    constexpr bool empty() const noexcept
+    {
+        return m_size == 0u;
+    }
+
+    constexpr T& operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    constexpr iterator begin() const noexcept
+    {
+        return m_data;
+    }
+    constexpr iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    /// Returns the span on the \a count elements from \a offset.
+    constexpr span subspan(size_type offset, size_type count) const
+    {
+        return span(m_data + offset, count);
+    }
+    /// Returns the span on the first \a count elements.
+    constexpr span first(size_type count) const
+    {
+        return span(m_data, count);
+    }
+};
+
+} // namespace comp
+
+#endif // COMP_SPAN_HPP
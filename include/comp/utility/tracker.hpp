@@ -2,33 +2,55 @@
 #define COMP_TRACKER_HPP
 
 #include <comp/config.hpp>
-#include <comp/wrap/memory.hpp>
 #include <comp/wrap/vector.hpp>
 
 namespace comp
 {
 
 /// The %DeleteObserver gets notified when a watched object is deleted. The watched object must
-/// derive from Notifier.
-class COMP_API DeleteObserver : public comp::enable_shared_from_this<DeleteObserver>
+/// derive from Notifier. The observer and the notifiers it watches keep non-owning links to each
+/// other, and either side unlinks itself from the other when it is destroyed. The links are guarded
+/// by a lock, and a destroyed observer waits for the notifications other threads deliver to it.
+class COMP_API DeleteObserver
 {
+    COMP_DISABLE_COPY_OR_MOVE(DeleteObserver)
+
 public:
     /// The %Notifier tells DeleteObserver instances that watch the deletion of the object.
     class COMP_API Notifier
     {
         friend class DeleteObserver;
     public:
+        /// Constructor.
+        explicit Notifier() = default;
+        /// Copying a notifier does not copy the observers watching the source object.
+        Notifier(const Notifier&);
+        Notifier& operator=(const Notifier&);
         /// Destructor.
         ~Notifier();
 
+        /// Returns the bytes held by the list of observers that watch the object.
+        size_t observerBytes() const
+        {
+            return m_observers.capacity() * sizeof(DeleteObserver*);
+        }
+
+    protected:
+        /// Tells the observers that the object is deleted, and unlinks them. The derived notifiers
+        /// call it first in their destructors, when the observers must stop using the object before
+        /// its members are destroyed.
+        void notifyObservers();
+
     private:
-        using Observers = comp::vector<comp::weak_ptr<DeleteObserver>>;
+        using Observers = comp::vector<DeleteObserver*>;
         /// The observers that watch the deletion of this object.
         Observers m_observers;
     };
 
-    /// Destructor.
-    virtual ~DeleteObserver() = default;
+    /// Constructor.
+    explicit DeleteObserver() = default;
+    /// Destructor. Unlinks the observer from the objects it watches.
+    virtual ~DeleteObserver();
 
     /// Watch the deletion of the \a object.
     /// \param object The object whose deletion to watch.
@@ -38,10 +60,28 @@ public:
     /// \param object The object to unwatch.
     void unwatch(Notifier& object);
 
+    /// Returns the bytes held by the list of objects the observer watches.
+    size_t notifierBytes() const
+    {
+        return m_notifiers.capacity() * sizeof(Notifier*);
+    }
+
 protected:
     /// Tells the observer that an \a object is deleted.
     /// \param object The object that is deleted.
     virtual void notifyDeleted(Notifier& object) = 0;
+
+    /// Unlinks the observer from the objects it watches, and waits for the notifications other
+    /// threads deliver to it. The derived observers call it first in their destructors, while the
+    /// members notifyDeleted() uses are alive. Do not call it with a lock notifyDeleted() takes.
+    void stopObserving();
+
+private:
+    using Notifiers = comp::vector<Notifier*>;
+    /// The objects watched by this observer.
+    Notifiers m_notifiers;
+    /// The number of deletion notifications in flight to this observer.
+    int m_notifying = 0;
 };
 
 } // comp
@@ -12,6 +12,10 @@ using std::find_if;
 using std::remove;
 using std::remove_if;
 using std::swap;
+using std::lower_bound;
+using std::upper_bound;
+using std::sort;
+using std::stable_sort;
 
 } // namespace comp
 
@@ -10,6 +10,12 @@ using std::atomic;
 using std::atomic_bool;
 using std::atomic_int;
 
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_acq_rel;
+using std::atomic_thread_fence;
+
 } // namespace comp
 
 #endif // COMP_ATOMIC_HPP
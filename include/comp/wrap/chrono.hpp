@@ -0,0 +1,13 @@
+#ifndef COMP_CHRONO_HPP
+#define COMP_CHRONO_HPP
+
+#include <chrono>
+
+namespace comp
+{
+
+namespace chrono = std::chrono;
+
+} // namespace comp
+
+#endif // COMP_CHRONO_HPP
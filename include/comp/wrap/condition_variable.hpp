@@ -0,0 +1,25 @@
+#ifndef COMP_CONDITION_VARIABLE_HPP
+#define COMP_CONDITION_VARIABLE_HPP
+
+#include <comp/config.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+
+#include <condition_variable>
+#include <mutex>
+
+#endif
+
+namespace comp
+{
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+
+using std::condition_variable_any;
+using std::unique_lock;
+
+#endif
+
+} // namespace comp
+
+#endif // COMP_CONDITION_VARIABLE_HPP
@@ -0,0 +1,13 @@
+#ifndef COMP_DEQUE_HPP
+#define COMP_DEQUE_HPP
+
+#include <deque>
+
+namespace comp
+{
+
+using std::deque;
+
+} // namespace comp
+
+#endif // COMP_DEQUE_HPP
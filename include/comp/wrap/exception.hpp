@@ -17,6 +17,20 @@ public:
     explicit bad_slot() = default;
 };
 
+/// Exception thrown when a slot is connected to a frozen signal.
+class COMP_API frozen_signal : public exception
+{
+public:
+    explicit frozen_signal() = default;
+};
+
+/// Exception thrown when a keyed dependency refers to a signal which is not tracked.
+class COMP_API untracked_signal : public exception
+{
+public:
+    explicit untracked_signal() = default;
+};
+
 }
 
 #endif // COMP_EXCEPTION_HPP
@@ -0,0 +1,24 @@
+#ifndef COMP_THREAD_HPP
+#define COMP_THREAD_HPP
+
+#include <comp/config.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+
+#include <thread>
+
+#endif
+
+namespace comp
+{
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+
+using std::thread;
+namespace this_thread = std::this_thread;
+
+#endif
+
+} // namespace comp
+
+#endif // COMP_THREAD_HPP
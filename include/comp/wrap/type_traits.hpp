@@ -17,11 +17,18 @@ using std::is_same;
 using std::is_same_v;
 using std::is_base_of;
 using std::is_base_of_v;
+using std::is_convertible;
+using std::is_convertible_v;
 using std::void_t;
 using std::is_void;
 using std::is_void_v;
 using std::remove_const_t;
+using std::remove_cv_t;
+using std::is_const;
+using std::is_const_v;
 using std::remove_reference_t;
+using std::is_function;
+using std::is_function_v;
 using std::is_member_function_pointer;
 using std::is_member_function_pointer_v;
 using std::is_pointer;
@@ -30,6 +37,10 @@ using std::remove_pointer;
 using std::remove_pointer_t;
 using std::conditional;
 using std::conditional_t;
+using std::is_trivially_copyable;
+using std::is_trivially_copyable_v;
+using std::is_invocable;
+using std::is_invocable_v;
 
 } // namespace traits
 
@@ -0,0 +1,14 @@
+#ifndef COMP_UNORDERED_MAP_HPP
+#define COMP_UNORDERED_MAP_HPP
+
+#include <unordered_map>
+
+namespace comp
+{
+
+using std::unordered_map;
+using std::unordered_multimap;
+
+} // namespace comp
+
+#endif // COMP_UNORDERED_MAP_HPP
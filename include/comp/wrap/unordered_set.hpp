@@ -0,0 +1,13 @@
+#ifndef COMP_UNORDERED_SET_HPP
+#define COMP_UNORDERED_SET_HPP
+
+#include <unordered_set>
+
+namespace comp
+{
+
+using std::unordered_set;
+
+} // namespace comp
+
+#endif // COMP_UNORDERED_SET_HPP
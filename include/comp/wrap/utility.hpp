@@ -9,6 +9,9 @@ namespace comp
 using std::forward;
 using std::move;
 using std::exchange;
+using std::index_sequence;
+using std::index_sequence_for;
+using std::in_place_index;
 
 /// Template function to call a function \a f on an rgument pack. The function is expected to take a single
 /// argument.
@@ -0,0 +1,15 @@
+#ifndef COMP_VARIANT_HPP
+#define COMP_VARIANT_HPP
+
+#include <variant>
+
+namespace comp
+{
+
+using std::variant;
+using std::get;
+using std::holds_alternative;
+
+} // namespace comp
+
+#endif // COMP_VARIANT_HPP
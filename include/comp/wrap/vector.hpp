@@ -59,10 +59,14 @@ void erase_first(vector<Type, Allocator>& vector, const VType& value)
 }
 
 /// Vector utility, removes the occurences for which the predicate gives affirmative result.
+/// \return The number of elements removed.
 template <typename Type, typename Allocator, typename Predicate>
-void erase_if(vector<Type, Allocator>& v, const Predicate& predicate)
+typename vector<Type, Allocator>::size_type erase_if(vector<Type, Allocator>& v, const Predicate& predicate)
 {
-    v.erase(remove_if(v.begin(), v.end(), predicate), v.end());
+    auto it = remove_if(v.begin(), v.end(), predicate);
+    auto removed = static_cast<typename vector<Type, Allocator>::size_type>(v.end() - it);
+    v.erase(it, v.end());
+    return removed;
 }
 
 } // namespace comp
@@ -1,35 +1,199 @@
 #include <comp/signal.hpp>
 #include <comp/utility/tracker.hpp>
+#include <comp/wrap/condition_variable.hpp>
+#include <typeinfo>
 
 namespace comp
 {
 
+namespace
+{
+
+// Guards the links between the delete observers and the notifiers.
+comp::mutex& trackerMutex()
+{
+    static comp::mutex mutex;
+    return mutex;
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// Wakes up the observers waiting for the notifications in flight. Never destroyed, notifiers may be
+// destroyed at exit.
+comp::condition_variable_any& notificationsDone()
+{
+    static auto condition = new comp::condition_variable_any;
+    return *condition;
+}
+#endif
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// Guards the waits for the activations in flight.
+comp::mutex& activationsMutex()
+{
+    static auto mutex = new comp::mutex;
+    return *mutex;
+}
+
+// Wakes up the threads waiting for the activations in flight. Never destroyed, activations may
+// complete at exit.
+comp::condition_variable_any& activationsDone()
+{
+    static auto condition = new comp::condition_variable_any;
+    return *condition;
+}
+
+// The number of threads waiting for activations, the activations skip the wake-up when zero.
+comp::atomic_int s_activationWaiters{0};
+#endif
+
+// A deletion notification the calling thread delivers.
+struct Notification
+{
+    DeleteObserver* observer;
+    Notification* previous;
+    // Set when the observer is destroyed from its own notification.
+    bool destroyed;
+};
+thread_local Notification* s_currentNotification = nullptr;
+
+}
+
+DeleteObserver::Notifier::Notifier(const Notifier&)
+{
+}
+
+DeleteObserver::Notifier& DeleteObserver::Notifier::operator=(const Notifier&)
+{
+    return *this;
+}
+
 DeleteObserver::Notifier::~Notifier()
 {
-    auto visitor = [this](auto& observer)
+    notifyObservers();
+}
+
+void DeleteObserver::Notifier::notifyObservers()
+{
+    comp::lock_guard lock(trackerMutex());
+    // Observers may unlink from this notifier while notified, so pop them one by one.
+    while (!m_observers.empty())
     {
-        auto tracked = observer.lock();
-        if (tracked)
+        auto observer = m_observers.back();
+        m_observers.pop_back();
+        erase_first(observer->m_notifiers, this);
+        ++observer->m_notifying;
+
+        Notification notification{observer, s_currentNotification, false};
+        s_currentNotification = &notification;
         {
-            tracked->notifyDeleted(*this);
+            comp::relock_guard relock(trackerMutex());
+            observer->notifyDeleted(*this);
         }
-    };
-    comp::for_each(m_observers.cbegin(), m_observers.cend(), visitor);
+        s_currentNotification = notification.previous;
+
+        if (!notification.destroyed && --observer->m_notifying == 0)
+        {
+#ifdef COMP_CONFIG_THREAD_ENABLED
+            notificationsDone().notify_all();
+#endif
+        }
+    }
+}
+
+DeleteObserver::~DeleteObserver()
+{
+    stopObserving();
+}
+
+void DeleteObserver::stopObserving()
+{
+    comp::lock_guard lock(trackerMutex());
+    for (auto notifier : m_notifiers)
+    {
+        erase(notifier->m_observers, this);
+    }
+    m_notifiers.clear();
+
+    // The notifications of the calling thread complete after the observer is destroyed.
+    auto ownNotifications = 0;
+    for (auto notification = s_currentNotification; notification; notification = notification->previous)
+    {
+        if (notification->observer == this)
+        {
+            notification->destroyed = true;
+            ++ownNotifications;
+        }
+    }
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    notificationsDone().wait(trackerMutex(), [this, ownNotifications]()
+    {
+        return m_notifying == ownNotifications;
+    });
+#else
+    COMP_ASSERT(m_notifying == ownNotifications);
+#endif
 }
 
 void DeleteObserver::watch(Notifier& object)
 {
-    object.m_observers.emplace_back(shared_from_this());
+    comp::lock_guard lock(trackerMutex());
+    object.m_observers.emplace_back(this);
+    m_notifiers.emplace_back(&object);
 }
 
 void DeleteObserver::unwatch(Notifier& object)
 {
-    auto predicate = [this](auto& weak)
+    comp::lock_guard lock(trackerMutex());
+    erase(object.m_observers, this);
+    erase(m_notifiers, &object);
+}
+
+bool SlotIdentity::isNull() const
+{
+    return *this == SlotIdentity();
+}
+
+std::size_t SlotIdentity::hash() const
+{
+    // FNV-1a over the receiver address and the callable bytes.
+    auto hash = std::size_t(14695981039346656037ull);
+    auto combine = [&hash](const unsigned char* bytes, std::size_t size)
     {
-        auto strong = weak.lock();
-        return (strong.get() == this);
+        for (auto i = 0u; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * std::size_t(1099511628211ull);
+        }
     };
-    erase_if(object.m_observers, predicate);
+    combine(reinterpret_cast<const unsigned char*>(&m_receiver), sizeof(m_receiver));
+    combine(m_callable, CallableSize);
+    return hash;
+}
+
+bool SlotIdentity::operator==(const SlotIdentity& other) const
+{
+    return m_receiver == other.m_receiver && std::memcmp(m_callable, other.m_callable, CallableSize) == 0;
+}
+
+namespace
+{
+
+// The memory used by the slots connected to signals, per slot class.
+comp::atomic<size_t> slotBytes[MemoryUsage::SlotClassCount] = {};
+comp::atomic<size_t> slotCount[MemoryUsage::SlotClassCount] = {};
+
+}
+
+thread_local SignalConcept::ConnectionConcept::ActivationGuard* SignalConcept::ConnectionConcept::s_currentActivation = nullptr;
+
+MemoryUsage memoryUsage()
+{
+    auto usage = MemoryUsage();
+    for (auto i = 0u; i < MemoryUsage::SlotClassCount; ++i)
+    {
+        usage.slotBytes[i] = slotBytes[i].load(memory_order_relaxed);
+        usage.slotCount[i] = slotCount[i].load(memory_order_relaxed);
+    }
+    return usage;
 }
 
 SignalConcept::ConnectionConcept::ConnectionConcept(SignalConcept& signal)
@@ -37,15 +201,97 @@ SignalConcept::ConnectionConcept::ConnectionConcept(SignalConcept& signal)
 {
 }
 
+SignalConcept::ConnectionConcept::~ConnectionConcept()
+{
+    stopObserving();
+    if (m_accountedSize > 0u)
+    {
+        const auto index = static_cast<size_t>(m_accountedClass);
+        slotBytes[index].fetch_sub(m_accountedSize, memory_order_relaxed);
+        slotCount[index].fetch_sub(1u, memory_order_relaxed);
+    }
+}
+
+SignalConcept::ConnectionConcept::ActivationGuard::ActivationGuard(ConnectionConcept& connection, bool counted)
+    : m_connection(connection)
+    , m_previous(s_currentActivation)
+    , m_counted(counted)
+{
+    if (m_counted)
+    {
+        ++m_connection.m_activations;
+    }
+    s_currentActivation = this;
+}
+
+SignalConcept::ConnectionConcept::ActivationGuard::~ActivationGuard()
+{
+    s_currentActivation = m_previous;
+    if (!m_counted)
+    {
+        return;
+    }
+    --m_connection.m_activations;
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    notifyActivationDone();
+#endif
+}
+
+void SignalConcept::ConnectionConcept::skipActivation()
+{
+    COMP_ASSERT(s_currentActivation && &s_currentActivation->m_connection == this);
+    s_currentActivation->m_skipped = true;
+}
+
+SlotClass SignalConcept::ConnectionConcept::slotClass() const
+{
+    return SlotClass::Other;
+}
+
+size_t SignalConcept::ConnectionConcept::objectSize() const
+{
+    return sizeof(ConnectionConcept);
+}
+
 void SignalConcept::ConnectionConcept::disconnectOverride()
 {
 }
 
+SlotIdentity SignalConcept::ConnectionConcept::identity() const
+{
+    return SlotIdentity();
+}
+
+bool SignalConcept::ConnectionConcept::isExpired() const
+{
+    return false;
+}
+
 void SignalConcept::ConnectionConcept::notifyDeleted(Notifier&)
 {
+    // The signal may hold the last reference to the connection, which may be released meanwhile.
+    if (!tryRetain())
+    {
+        return;
+    }
+    auto keepAlive = ConnectionPtr(this, false);
     disconnect();
 }
 
+bool SignalConcept::ConnectionConcept::invalidate()
+{
+    auto signal = m_signal.load();
+    while (signal)
+    {
+        if (m_signal.compare_exchange_weak(signal, nullptr))
+        {
+            disconnectOverride();
+            return true;
+        }
+    }
+    return false;
+}
+
 bool SignalConcept::ConnectionConcept::isValid() const
 {
     return m_signal != nullptr;
@@ -60,8 +306,7 @@ void SignalConcept::ConnectionConcept::disconnect()
 
     disconnectOverride();
 
-    auto tmp = m_signal;
-    m_signal = nullptr;
+    auto tmp = m_signal.exchange(nullptr);
     if (tmp)
     {
         tmp->removeConnection(*this);
@@ -69,6 +314,46 @@ void SignalConcept::ConnectionConcept::disconnect()
 }
 
 
+void SignalConcept::ConnectionConcept::disconnectAndWait()
+{
+    // Keep the connection alive, the signal may hold the last reference.
+    auto keepAlive = ConnectionPtr(this);
+    auto signal = m_signal.load();
+    disconnect();
+
+    // The activations of the calling thread complete after this call returns.
+    auto ownActivations = 0;
+    auto ownUncountedActivations = 0;
+    for (auto activation = s_currentActivation; activation; activation = activation->m_previous)
+    {
+        if (&activation->m_connection == this)
+        {
+            ++(activation->m_counted ? ownActivations : ownUncountedActivations);
+        }
+    }
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    waitForActivations([this, ownActivations]() { return m_activations == ownActivations; });
+#else
+    COMP_ASSERT(m_activations == ownActivations);
+#endif
+    // The signal counts the activations from its snapshots. Like disconnect(), this needs the signal
+    // alive.
+    if (signal)
+    {
+        signal->waitForSnapshots(*this, ownUncountedActivations);
+    }
+}
+
+bool SignalConcept::ConnectionConcept::isActive() const
+{
+    return m_activations > 0;
+}
+
+void SignalConcept::ConnectionConcept::flush()
+{
+}
+
 SignalConcept::~SignalConcept()
 {
     setBlocked(true);
@@ -84,10 +369,314 @@ void SignalConcept::setBlocked(bool blocked)
     m_isBlocked = blocked;
 }
 
-void SignalConcept::addConnection(ConnectionPtr connection)
+bool SignalConcept::hasUniqueConnections() const
+{
+    return m_uniqueConnections;
+}
+void SignalConcept::setUniqueConnections(bool unique)
+{
+    m_uniqueConnections = unique;
+}
+
+bool SignalConcept::hasUnorderedConnections() const
+{
+    return m_unorderedConnections;
+}
+void SignalConcept::setUnorderedConnections(bool unordered)
 {
     comp::lock_guard lock(*this);
-    m_connections.emplace_back(connection);
+    if (m_unorderedConnections == unordered)
+    {
+        return;
+    }
+    m_unorderedConnections = unordered;
+    if (unordered)
+    {
+        comp::relock_guard relock(*this);
+        regroupConnections();
+    }
+    else
+    {
+        auto higherPriority = [](const ConnectionPtr& lhs, const ConnectionPtr& rhs)
+        {
+            return lhs->m_priority > rhs->m_priority;
+        };
+        stable_sort(m_connections.begin(), m_connections.end(), higherPriority);
+        m_revision.fetch_add(1u, memory_order_release);
+    }
+}
+
+void SignalConcept::regroupConnections()
+{
+    comp::lock_guard lock(*this);
+    if (!m_unorderedConnections)
+    {
+        return;
+    }
+
+    removeInvalidConnections();
+    // The dynamic type of the connection identifies the activation code of the slot.
+    auto slotClass = [](const ConnectionPtr& lhs, const ConnectionPtr& rhs)
+    {
+        return typeid(*lhs).hash_code() < typeid(*rhs).hash_code();
+    };
+    stable_sort(m_connections.begin(), m_connections.end(), slotClass);
+    for (size_t position = 0u; position < m_connections.size(); ++position)
+    {
+        m_connections[position]->m_position = position;
+    }
+    m_revision.fetch_add(1u, memory_order_release);
+}
+
+void SignalConcept::waitForSnapshots(ConnectionConcept&, int)
+{
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+void SignalConcept::waitForActivations(const comp::function<bool()>& done)
+{
+    comp::unique_lock lock(activationsMutex());
+    ++s_activationWaiters;
+    activationsDone().wait(lock, done);
+    --s_activationWaiters;
+}
+
+void SignalConcept::notifyActivationDone()
+{
+    if (s_activationWaiters > 0)
+    {
+        comp::lock_guard lock(activationsMutex());
+        activationsDone().notify_all();
+    }
+}
+#endif
+
+thread_local SignalConcept::FrozenActivationGuard* SignalConcept::FrozenActivationGuard::s_current = nullptr;
+
+SignalConcept::FrozenActivationGuard::FrozenActivationGuard(SignalConcept& signal)
+    : m_signal(signal)
+    , m_previous(s_current)
+{
+    ++m_signal.m_frozenActivations;
+    s_current = this;
+}
+
+SignalConcept::FrozenActivationGuard::~FrozenActivationGuard()
+{
+    s_current = m_previous;
+    if (--m_signal.m_frozenActivations == 0 && m_signal.m_freezePending)
+    {
+        comp::lock_guard lock(m_signal);
+        if (m_signal.m_freezePending && m_signal.m_frozenActivations == 0)
+        {
+            m_signal.compactFrozenConnections();
+        }
+    }
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    notifyActivationDone();
+#endif
+}
+
+bool SignalConcept::FrozenActivationGuard::isActiveOnThisThread(const SignalConcept& signal)
+{
+    for (auto activation = s_current; activation; activation = activation->m_previous)
+    {
+        if (&activation->m_signal == &signal)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SignalConcept::freeze()
+{
+    comp::lock_guard lock(*this);
+    if (m_isFrozen)
+    {
+        return;
+    }
+
+    // The activation of the calling thread runs the frozen connections by reference, compact the
+    // connections when it completes.
+    if (FrozenActivationGuard::isActiveOnThisThread(*this))
+    {
+        m_freezePending = true;
+        m_isFrozen = true;
+        return;
+    }
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    // The activations of the previous freeze may still run the frozen connections.
+    while (m_frozenActivations > 0)
+    {
+        comp::relock_guard relock(*this);
+        waitForActivations([this]() { return m_frozenActivations == 0; });
+    }
+#else
+    COMP_ASSERT(m_frozenActivations == 0);
+#endif
+    compactFrozenConnections();
+    m_isFrozen = true;
+}
+
+void SignalConcept::thaw()
+{
+    comp::lock_guard lock(*this);
+    m_isFrozen = false;
+    m_freezePending = false;
+    releaseFrozenConnections();
+}
+
+bool SignalConcept::isFrozen() const
+{
+    return m_isFrozen;
+}
+
+void SignalConcept::reserve(size_t count)
+{
+    comp::lock_guard lock(*this);
+    m_connections.reserve(count);
+}
+
+size_t SignalConcept::capacity()
+{
+    comp::lock_guard lock(*this);
+    return m_connections.capacity();
+}
+
+void SignalConcept::shrinkToFit()
+{
+    comp::lock_guard lock(*this);
+    removeInvalidConnections();
+    m_connections.shrink_to_fit();
+}
+
+bool SignalConcept::hasAutoShrink() const
+{
+    return m_autoShrink;
+}
+
+void SignalConcept::setAutoShrink(bool autoShrink)
+{
+    m_autoShrink = autoShrink;
+}
+
+MemoryUsage SignalConcept::memoryUsage()
+{
+    auto usage = MemoryUsage();
+    comp::lock_guard lock(*this);
+    usage.containers = (m_connections.capacity() + m_frozenConnections.capacity()) * sizeof(ConnectionPtr);
+    if (m_index)
+    {
+        // Each index node holds the entry, the link to the next node and the hash.
+        using Entry = SlotIndex::value_type;
+        usage.containers += sizeof(SlotIndex) + m_index->bucket_count() * sizeof(void*) + m_index->size() * (sizeof(Entry) + sizeof(void*) + sizeof(size_t));
+    }
+    usage.observers = observerBytes();
+
+    for (auto& connection : m_connections)
+    {
+        if (!connection)
+        {
+            continue;
+        }
+        const auto index = static_cast<size_t>(connection->slotClass());
+        usage.slotBytes[index] += connection->objectSize();
+        ++usage.slotCount[index];
+        usage.observers += connection->notifierBytes();
+    }
+    return usage;
+}
+
+size_t SignalConcept::bytesUsed()
+{
+    return memoryUsage().total();
+}
+
+ConnectionPtr SignalConcept::addConnection(ConnectionPtr connection, int priority)
+{
+    comp::lock_guard lock(*this);
+    if (m_isFrozen)
+    {
+        throw comp::frozen_signal();
+    }
+    auto identity = (m_index || m_uniqueConnections) ? connection->identity() : SlotIdentity();
+    if (m_uniqueConnections && !identity.isNull())
+    {
+        if (!m_index)
+        {
+            buildIndex();
+        }
+        auto range = m_index->equal_range(identity);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second->isValid() && !it->second->isExpired())
+            {
+                auto existing = ConnectionPtr(it->second);
+                if (existing->m_priority != priority)
+                {
+                    reprioritize(existing, priority);
+                }
+                return existing;
+            }
+        }
+    }
+
+    connection->m_priority = priority;
+    insertConnection(connection);
+    if (m_index && !identity.isNull())
+    {
+        m_index->emplace(identity, connection.get());
+    }
+    m_revision.fetch_add(1u, memory_order_release);
+
+    if (connection->m_accountedSize == 0u)
+    {
+        connection->m_accountedSize = connection->objectSize();
+        connection->m_accountedClass = connection->slotClass();
+        const auto index = static_cast<size_t>(connection->m_accountedClass);
+        slotBytes[index].fetch_add(connection->m_accountedSize, memory_order_relaxed);
+        slotCount[index].fetch_add(1u, memory_order_relaxed);
+    }
+    return connection;
+}
+
+void SignalConcept::insertConnection(const ConnectionPtr& connection)
+{
+    const auto priority = connection->m_priority;
+    if (m_unorderedConnections)
+    {
+        connection->m_position = m_connections.size();
+        m_connections.emplace_back(connection);
+    }
+    else if (m_connections.empty() || m_connections.back()->m_priority >= priority)
+    {
+        m_connections.emplace_back(connection);
+    }
+    else
+    {
+        // Insert after the last connection with the same or higher priority. The search is
+        // logarithmic, the insertion moves the connections after the position, and is linear.
+        auto lowerPriority = [](int priority, const ConnectionPtr& connection)
+        {
+            return priority > connection->m_priority;
+        };
+        auto position = upper_bound(m_connections.begin(), m_connections.end(), priority, lowerPriority);
+        m_connections.emplace(position, connection);
+    }
+}
+
+void SignalConcept::reprioritize(const ConnectionPtr& connection, int priority)
+{
+    connection->m_priority = priority;
+    // The unordered signals ignore the priority until the priority order is restored.
+    if (m_unorderedConnections)
+    {
+        return;
+    }
+    erase_first(m_connections, connection);
+    insertConnection(connection);
+    m_revision.fetch_add(1u, memory_order_release);
 }
 
 void SignalConcept::disconnect(ConnectionConcept& connection)
@@ -97,27 +686,91 @@ void SignalConcept::disconnect(ConnectionConcept& connection)
 
 void SignalConcept::disconnect()
 {
-    comp::lock_guard lock(*this);
-    while (!m_connections.empty())
     {
-        comp::relock_guard relock(*this);
-        removeConnection(*m_connections.back());
+        comp::lock_guard lock(*this);
+        while (!m_connections.empty())
+        {
+            comp::relock_guard relock(*this);
+            removeConnection(*m_connections.back());
+        }
+    }
+    invalidateRetiredConnections(true);
+}
+
+void SignalConcept::flush()
+{
+    auto connections = ConnectionContainer();
+    {
+        comp::lock_guard lock(*this);
+        connections = m_connections;
+    }
+    for (auto& connection : connections)
+    {
+        if (connection)
+        {
+            connection->flush();
+        }
     }
 }
 
+int SignalConcept::disconnect(const SlotIdentity& identity)
+{
+    auto connections = ConnectionContainer();
+    {
+        comp::lock_guard lock(*this);
+        if (!m_index)
+        {
+            buildIndex();
+        }
+        auto range = m_index->equal_range(identity);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            connections.emplace_back(it->second);
+        }
+        m_index->erase(range.first, range.second);
+    }
+
+    // Invalidate outside the lock, the connections may clean up on invalidation.
+    auto result = 0;
+    for (auto& connection : connections)
+    {
+        if (connection->invalidate())
+        {
+            ++result;
+        }
+    }
+    return result;
+}
+
 void SignalConcept::removeConnection(ConnectionConcept& connection)
 {
     comp::lock_guard lock(*this);
-    auto predicate = [&connection](auto conn)
+    auto predicate = [&connection](const auto& conn)
     {
         return conn.get() == &connection;
     };
-    auto it = find_if(m_connections.begin(), m_connections.end(), predicate);
+    auto position = connection.m_position;
+    auto it = (m_unorderedConnections && position < m_connections.size() && predicate(m_connections[position]))
+        ? m_connections.begin() + position
+        : find_if(m_connections.begin(), m_connections.end(), predicate);
 
     if (it != m_connections.end())
     {
         auto keepAlive = *it;
-        m_connections.erase(it);
+        if (m_unorderedConnections)
+        {
+            swapAndPop(static_cast<size_t>(it - m_connections.begin()));
+        }
+        else
+        {
+            m_connections.erase(it);
+        }
+        m_revision.fetch_add(1u, memory_order_release);
+        autoShrink();
+        if (m_index && keepAlive)
+        {
+            unindex(*keepAlive);
+        }
 
         if (keepAlive)
         {
@@ -127,4 +780,208 @@ void SignalConcept::removeConnection(ConnectionConcept& connection)
     }
 }
 
+void SignalConcept::removeInvalidConnections()
+{
+    releaseFrozenConnections();
+    auto predicate = [this](const auto& connection)
+    {
+        if (connection && connection->isValid())
+        {
+            return false;
+        }
+        if (connection && m_index)
+        {
+            unindex(*connection);
+        }
+        return true;
+    };
+    size_t removed = 0u;
+    if (m_unorderedConnections)
+    {
+        for (size_t position = 0u; position < m_connections.size();)
+        {
+            if (predicate(m_connections[position]))
+            {
+                swapAndPop(position);
+                ++removed;
+            }
+            else
+            {
+                ++position;
+            }
+        }
+    }
+    else
+    {
+        removed = erase_if(m_connections, predicate);
+    }
+    if (removed > 0u)
+    {
+        m_revision.fetch_add(1u, memory_order_release);
+        autoShrink();
+    }
+}
+
+void SignalConcept::releaseFrozenConnections()
+{
+    // An activation entering after this check sees the signal thawed.
+    if (m_isFrozen || m_frozenConnections.empty() || m_frozenActivations > 0)
+    {
+        return;
+    }
+    m_frozenConnections = ConnectionContainer();
+}
+
+void SignalConcept::compactFrozenConnections()
+{
+    removeInvalidConnections();
+    m_frozenConnections.assign(m_connections.begin(), m_connections.end());
+    m_frozenConnections.shrink_to_fit();
+    m_freezePending = false;
+}
+
+void SignalConcept::swapAndPop(size_t position)
+{
+    if (position + 1u < m_connections.size())
+    {
+        m_connections[position] = comp::move(m_connections.back());
+        if (m_connections[position])
+        {
+            m_connections[position]->m_position = position;
+        }
+    }
+    m_connections.pop_back();
+}
+
+void SignalConcept::replaceConnections(SignalConcept& staging)
+{
+    auto connections = ConnectionContainer();
+    {
+        comp::lock_guard lock(staging);
+        staging.removeInvalidConnections();
+        connections.swap(staging.m_connections);
+        staging.m_index.reset();
+    }
+    for (auto& connection : connections)
+    {
+        // The connection disconnected from the staging signal is dropped on the next activation.
+        auto expected = &staging;
+        connection->m_signal.compare_exchange_strong(expected, this);
+    }
+
+    auto frozen = false;
+    {
+        comp::lock_guard lock(*this);
+        frozen = m_isFrozen;
+        if (!frozen)
+        {
+            if (m_unorderedConnections)
+            {
+                for (size_t position = 0u; position < connections.size(); ++position)
+                {
+                    connections[position]->m_position = position;
+                }
+            }
+            m_connections.swap(connections);
+            if (m_index)
+            {
+                buildIndex();
+            }
+            // The activations in flight run their snapshots to the end with the replaced
+            // connections, the last of them invalidates the retired connections.
+            m_retiredRevision = m_revision.fetch_add(1u, memory_order_release) + 1u;
+            m_retiredConnections.insert(m_retiredConnections.end(), connections.begin(), connections.end());
+            m_hasRetiredConnections = true;
+            connections.clear();
+        }
+    }
+
+    if (frozen)
+    {
+        // A frozen signal rejects the new connections.
+        for (auto& connection : connections)
+        {
+            connection->invalidate();
+        }
+        throw comp::frozen_signal();
+    }
+    releaseRetiredConnections();
+}
+
+bool SignalConcept::hasSnapshotsBefore(unsigned revision)
+{
+    // The activation which locked the guard, but did not take its snapshot yet, holds an older
+    // revision, and releases the retired connections when it completes.
+    return m_emitGuard.isLocked() && m_snapshotRevision < revision;
+}
+
+void SignalConcept::invalidateRetiredConnections(bool force)
+{
+    auto connections = ConnectionContainer();
+    {
+        comp::lock_guard lock(*this);
+        if (!force && hasSnapshotsBefore(m_retiredRevision))
+        {
+            return;
+        }
+        connections.swap(m_retiredConnections);
+        m_hasRetiredConnections = false;
+    }
+    // Invalidate the connections outside the lock, the connections may clean up on invalidation.
+    for (auto& connection : connections)
+    {
+        connection->invalidate();
+    }
+}
+
+void SignalConcept::buildIndex()
+{
+    m_index = comp::make_unique<SlotIndex>();
+    for (auto& connection : m_connections)
+    {
+        auto identity = connection ? connection->identity() : SlotIdentity();
+        if (!identity.isNull())
+        {
+            m_index->emplace(identity, connection.get());
+        }
+    }
+}
+
+void SignalConcept::autoShrink()
+{
+    // Small storages are not worth the reallocation.
+    constexpr size_t minimumCapacity = 64u;
+    if (!m_autoShrink || m_connections.capacity() < minimumCapacity || m_connections.size() >= m_connections.capacity() / 4u)
+    {
+        return;
+    }
+
+    // Keep room for the signal to grow back without reallocating right away.
+    auto connections = ConnectionContainer();
+    connections.reserve(m_connections.size() * 2u);
+    for (auto& connection : m_connections)
+    {
+        connections.emplace_back(comp::move(connection));
+    }
+    m_connections.swap(connections);
+}
+
+void SignalConcept::unindex(ConnectionConcept& connection)
+{
+    auto identity = connection.identity();
+    if (identity.isNull())
+    {
+        return;
+    }
+    auto range = m_index->equal_range(identity);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == &connection)
+        {
+            m_index->erase(it);
+            return;
+        }
+    }
+}
+
 }
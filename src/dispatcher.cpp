@@ -0,0 +1,138 @@
+#include <comp/dispatcher.hpp>
+
+namespace comp
+{
+
+Dispatcher::~Dispatcher()
+{
+    // The queued connections disconnect, and wait for their posts in flight, before the queues are
+    // destroyed.
+    notifyObservers();
+
+    auto levels = comp::vector<Level>();
+    auto idleInvocations = comp::deque<Invocation>();
+    {
+        comp::lock_guard lock(*this);
+        comp::swap(levels, m_levels);
+        comp::swap(idleInvocations, m_idleInvocations);
+        m_pendingCount = 0u;
+    }
+}
+
+void Dispatcher::post(const void* source, int priority, Invocation invocation)
+{
+    comp::lock_guard lock(*this);
+    auto higherPriority = [](const Level& level, int priority)
+    {
+        return level.priority > priority;
+    };
+    auto level = lower_bound(m_levels.begin(), m_levels.end(), priority, higherPriority);
+    if (level == m_levels.end() || level->priority != priority)
+    {
+        level = m_levels.insert(level, Level{priority, {}});
+    }
+
+    auto sameSource = [source](const Source& item)
+    {
+        return item.id == source;
+    };
+    auto it = find_if(level->sources.begin(), level->sources.end(), sameSource);
+    if (it == level->sources.end())
+    {
+        level->sources.push_back(Source{source, {}});
+        it = level->sources.end() - 1;
+    }
+    it->invocations.emplace_back(comp::move(invocation));
+    ++m_pendingCount;
+}
+
+int Dispatcher::dispatch(Clock::duration budget)
+{
+    const auto deadline = Clock::now() + budget;
+    auto result = 0;
+    auto invocation = Invocation();
+    while (takeNext(invocation))
+    {
+        invocation();
+        ++result;
+        if (Clock::now() >= deadline)
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+int Dispatcher::dispatch()
+{
+    auto result = 0;
+    auto invocation = Invocation();
+    while (takeNext(invocation))
+    {
+        invocation();
+        ++result;
+    }
+    return result;
+}
+
+std::size_t Dispatcher::pendingCount()
+{
+    comp::lock_guard lock(*this);
+    return m_pendingCount;
+}
+
+void Dispatcher::postIdle(Invocation invocation)
+{
+    comp::lock_guard lock(*this);
+    m_idleInvocations.emplace_back(comp::move(invocation));
+}
+
+int Dispatcher::dispatchIdle()
+{
+    auto invocations = comp::deque<Invocation>();
+    {
+        comp::lock_guard lock(*this);
+        comp::swap(invocations, m_idleInvocations);
+    }
+
+    for (auto& invocation : invocations)
+    {
+        invocation();
+    }
+    return static_cast<int>(invocations.size());
+}
+
+std::size_t Dispatcher::idleCount()
+{
+    comp::lock_guard lock(*this);
+    return m_idleInvocations.size();
+}
+
+bool Dispatcher::takeNext(Invocation& invocation)
+{
+    comp::lock_guard lock(*this);
+    if (m_levels.empty())
+    {
+        return false;
+    }
+
+    auto& level = m_levels.front();
+    auto source = comp::move(level.sources.front());
+    level.sources.pop_front();
+    invocation = comp::move(source.invocations.front());
+    source.invocations.pop_front();
+    --m_pendingCount;
+
+    // Move the source to the back of its level, so the other sources are served next.
+    if (!source.invocations.empty())
+    {
+        level.sources.push_back(comp::move(source));
+    }
+    else if (level.sources.empty())
+    {
+        m_levels.erase(m_levels.begin());
+    }
+    return true;
+}
+
+} // namespace comp
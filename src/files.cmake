@@ -2,22 +2,42 @@ set(HEADERS
     #SSIG
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/algorithm.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/atomic.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/chrono.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/condition_variable.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/deque.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/exception.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/function_traits.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/functional.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/memory.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/mutex.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/optional.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/thread.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/tuple.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/type_traits.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/unordered_map.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/unordered_set.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/utility.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/variant.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wrap/vector.hpp
 
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/utility/lockable.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/utility/memory_usage.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/utility/ref_counted.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/utility/slot_identity.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/utility/span.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/utility/tracker.hpp
 
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/concept/signal.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/config.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/dispatcher.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/invalidating_cache.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/observable.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/sharded_signal.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/signal.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/signal_array.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/signal_stream.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/signal_waiter.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/static_signal.hpp
 
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/signal
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/comp/wraps
@@ -31,4 +51,6 @@ set(PRIVATE_HEADERS
 
 set(SOURCES
     ${CMAKE_CURRENT_SOURCE_DIR}/comp_lib.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/dispatcher.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/signal_waiter.cpp
     )
@@ -0,0 +1,33 @@
+#include <comp/signal_waiter.hpp>
+
+namespace comp
+{
+
+bool SignalWaiter::isReady() const
+{
+    return m_isReady;
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+void SignalWaiter::wait()
+{
+    comp::unique_lock lock(*this);
+    m_condition.wait(lock, [this]() { return m_isReady.load(); });
+}
+
+bool SignalWaiter::waitFor(comp::chrono::nanoseconds timeout)
+{
+    comp::unique_lock lock(*this);
+    return m_condition.wait_for(lock, timeout, [this]() { return m_isReady.load(); });
+}
+#endif
+
+void SignalWaiter::setReady()
+{
+    m_isReady = true;
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    m_condition.notify_all();
+#endif
+}
+
+} // namespace comp
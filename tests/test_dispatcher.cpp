@@ -0,0 +1,306 @@
+#include "test_base.hpp"
+#include <comp/dispatcher.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
+
+namespace
+{
+
+class DispatcherTest : public SignalTest
+{
+public:
+    comp::Dispatcher dispatcher;
+    comp::vector<int> invocations;
+
+    auto recorder(int id)
+    {
+        return [this, id]() { invocations.push_back(id); };
+    }
+};
+
+struct Payload
+{
+    static inline int copyCount = 0;
+
+    explicit Payload() = default;
+    Payload(const Payload&)
+    {
+        ++copyCount;
+    }
+    Payload(Payload&&) = default;
+    Payload& operator=(const Payload&)
+    {
+        ++copyCount;
+        return *this;
+    }
+};
+
+}
+
+// The queued slot is invoked when the dispatcher is drained, and not when the signal is activated.
+TEST_F(DispatcherTest, queuedSlotIsInvokedOnDispatch)
+{
+    comp::Signal<void(int, std::string)> signal;
+    auto connection = signal.connect(dispatcher, &functionWithIntAndStringArgument);
+    EXPECT_TRUE(connection);
+
+    EXPECT_EQ(1, signal(10, "alpha"));
+    EXPECT_EQ(0u, intValue);
+    EXPECT_EQ(1u, dispatcher.pendingCount());
+
+    EXPECT_EQ(1, dispatcher.dispatch());
+    EXPECT_EQ(10u, intValue);
+    EXPECT_EQ("alpha", stringValue);
+    EXPECT_EQ(0u, dispatcher.pendingCount());
+}
+
+// The invocations that do not fit in the budget are carried over to the next dispatch.
+TEST_F(DispatcherTest, dispatchWithBudget)
+{
+    comp::Signal<void()> signal;
+    signal.connect(dispatcher, recorder(1));
+    signal();
+    signal();
+    signal();
+
+    // A spent budget dispatches a single invocation.
+    EXPECT_EQ(1, dispatcher.dispatch(comp::Dispatcher::Clock::duration::zero()));
+    EXPECT_EQ(2u, dispatcher.pendingCount());
+    EXPECT_EQ(2, dispatcher.dispatch(comp::chrono::seconds(10)));
+    EXPECT_EQ((comp::vector<int>{1, 1, 1}), invocations);
+}
+
+// The invocations of the queued slots with higher priority are dispatched first.
+TEST_F(DispatcherTest, dispatchByPriority)
+{
+    comp::Signal<void()> signal1;
+    comp::Signal<void()> signal2;
+    signal1.connect(dispatcher, recorder(1));
+    signal2.connect(10, dispatcher, recorder(2));
+
+    signal1();
+    signal1();
+    signal2();
+    dispatcher.dispatch();
+    EXPECT_EQ((comp::vector<int>{2, 1, 1}), invocations);
+}
+
+// The signals posting with the same priority are served round-robin.
+TEST_F(DispatcherTest, dispatchSignalsFairly)
+{
+    comp::Signal<void()> signal1;
+    comp::Signal<void()> signal2;
+    signal1.connect(dispatcher, recorder(1));
+    signal2.connect(dispatcher, recorder(2));
+
+    signal1();
+    signal1();
+    signal1();
+    signal2();
+    signal2();
+    dispatcher.dispatch();
+    EXPECT_EQ((comp::vector<int>{1, 2, 1, 2, 1}), invocations);
+}
+
+// The queued slot published by replaceSlots() posts on behalf of the signal that holds it.
+TEST_F(DispatcherTest, replacedQueuedSlotPostsAsSignal)
+{
+    comp::Signal<void()> signal1;
+    comp::Signal<void()> signal2;
+    signal1.replaceSlots([this](auto& staging) { staging.connect(dispatcher, recorder(1)); });
+    signal1.connect(dispatcher, recorder(2));
+    signal2.connect(dispatcher, recorder(3));
+
+    signal1();
+    signal2();
+    dispatcher.dispatch();
+    EXPECT_EQ((comp::vector<int>{1, 3, 2}), invocations);
+}
+
+// A queued slot disconnected before the dispatch is not invoked.
+TEST_F(DispatcherTest, disconnectBeforeDispatch)
+{
+    comp::Signal<void()> signal;
+    auto connection = signal.connect(dispatcher, recorder(1));
+    signal();
+    connection->disconnect();
+
+    EXPECT_EQ(1, dispatcher.dispatch());
+    EXPECT_TRUE(invocations.empty());
+}
+
+// The queued slots of an activation share one copy of the arguments.
+TEST_F(DispatcherTest, queuedSlotsShareArguments)
+{
+    comp::Signal<void(const Payload&)> signal;
+    comp::vector<const Payload*> received;
+    auto slot = [&received](const Payload& payload)
+    {
+        received.push_back(&payload);
+    };
+    for (auto i = 0; i < 5; ++i)
+    {
+        signal.connect(dispatcher, slot);
+    }
+
+    Payload payload;
+    Payload::copyCount = 0;
+    EXPECT_EQ(5, signal(payload));
+    EXPECT_EQ(1, Payload::copyCount);
+
+    EXPECT_EQ(5, dispatcher.dispatch());
+    ASSERT_EQ(5u, received.size());
+    for (auto address : received)
+    {
+        EXPECT_EQ(received[0], address);
+    }
+    EXPECT_NE(&payload, received[0]);
+}
+
+// The queued slots that modify their arguments get their own copy.
+TEST_F(DispatcherTest, queuedSlotsWithMutableArguments)
+{
+    comp::Signal<void(int&)> signal;
+    int sum = 0;
+    auto slot = [&sum](int& value)
+    {
+        value *= 2;
+        sum += value;
+    };
+    signal.connect(dispatcher, slot);
+    signal.connect(dispatcher, slot);
+
+    int value = 1;
+    EXPECT_EQ(2, signal(value));
+    EXPECT_EQ(2, dispatcher.dispatch());
+    EXPECT_EQ(4, sum);
+    EXPECT_EQ(1, value);
+}
+
+// The queued slots that take the connection, and modify their arguments, get their own copy.
+TEST_F(DispatcherTest, queuedSlotsWithConnectionAndMutableArguments)
+{
+    comp::Signal<void(int&)> signal;
+    comp::vector<int> received;
+    auto withConnection = [&received](comp::ConnectionPtr, int& value)
+    {
+        value += 10;
+        received.push_back(value);
+    };
+    auto withConnectionRef = [&received](comp::ConnectionRef, int& value)
+    {
+        value += 20;
+        received.push_back(value);
+    };
+    signal.connect(dispatcher, withConnection);
+    signal.connect(dispatcher, withConnectionRef);
+    signal.connect(dispatcher, withConnection);
+
+    int value = 1;
+    EXPECT_EQ(3, signal(value));
+    EXPECT_EQ(3, dispatcher.dispatch());
+    EXPECT_EQ((comp::vector<int>{11, 21, 11}), received);
+    EXPECT_EQ(1, value);
+}
+
+// The queued connections disconnect when the dispatcher is destroyed.
+TEST_F(DispatcherTest, destroyDispatcher)
+{
+    comp::Signal<void()> signal;
+    auto dispatcher = comp::make_unique<comp::Dispatcher>();
+    auto connection = signal.connect(*dispatcher, &function);
+    signal();
+
+    dispatcher.reset();
+    EXPECT_FALSE(connection->isValid());
+    EXPECT_EQ(0, signal());
+    EXPECT_EQ(0u, functionCallCount);
+}
+
+// The coalesced connections disconnect when the dispatcher is destroyed, and the pending invocations
+// are dropped.
+TEST_F(DispatcherTest, destroyDispatcherWithCoalescedSlot)
+{
+    comp::Signal<void(int)> signal;
+    auto dispatcher = comp::make_unique<comp::Dispatcher>();
+    auto connection = signal.connectCoalesced(*dispatcher, &functionWithIntArgument);
+    signal(10);
+
+    dispatcher.reset();
+    EXPECT_FALSE(connection->isValid());
+    EXPECT_EQ(0, signal(20));
+    EXPECT_EQ(0u, intValue);
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The dispatcher destroyed while an other thread activates its queued connections waits for the
+// posts in flight.
+TEST_F(DispatcherTest, destroyDispatcherWhilePosting)
+{
+    for (auto i = 0; i < 20; ++i)
+    {
+        comp::Signal<void(int)> signal;
+        auto dispatcher = comp::make_unique<comp::Dispatcher>();
+        auto queued = signal.connect(*dispatcher, &functionWithIntArgument);
+        auto coalesced = signal.connectCoalesced(*dispatcher, &functionWithIntArgument);
+        comp::atomic_bool posted = false;
+
+        std::thread emitter([&signal, &queued, &posted]()
+        {
+            while (queued->isValid())
+            {
+                signal(1);
+                posted = true;
+            }
+        });
+        while (!posted)
+        {
+            std::this_thread::yield();
+        }
+        dispatcher.reset();
+        emitter.join();
+        EXPECT_FALSE(coalesced->isValid());
+    }
+    EXPECT_EQ(0u, intValue);
+}
+#endif
+
+// The coalesced slot keeps a single pending invocation with the latest arguments, flushed when the dispatcher goes idle.
+TEST_F(DispatcherTest, coalescedSlotReceivesLatestArguments)
+{
+    comp::Signal<void(int)> signal;
+    auto slot = [this](int value)
+    {
+        invocations.push_back(value);
+    };
+    signal.connectCoalesced(dispatcher, slot);
+    signal.connectCoalesced(dispatcher, slot);
+
+    signal(1);
+    signal(2);
+    signal(3);
+    EXPECT_EQ(2u, dispatcher.idleCount());
+    // Idle invocations are not dispatched with the queued ones.
+    EXPECT_EQ(0, dispatcher.dispatch());
+
+    EXPECT_EQ(2, dispatcher.dispatchIdle());
+    EXPECT_EQ((comp::vector<int>{3, 3}), invocations);
+
+    signal(4);
+    EXPECT_EQ(2, dispatcher.dispatchIdle());
+    EXPECT_EQ((comp::vector<int>{3, 3, 4, 4}), invocations);
+}
+
+// A coalesced slot disconnected before the flush is not invoked.
+TEST_F(DispatcherTest, coalescedSlotDisconnectedBeforeFlush)
+{
+    comp::Signal<void(int)> signal;
+    auto connection = signal.connectCoalesced(dispatcher, &functionWithIntArgument);
+    signal(10);
+    connection->disconnect();
+
+    dispatcher.dispatchIdle();
+    EXPECT_EQ(0u, intValue);
+}
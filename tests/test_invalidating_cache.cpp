@@ -0,0 +1,126 @@
+#include "test_base.hpp"
+#include <comp/invalidating_cache.hpp>
+
+namespace
+{
+
+class InvalidatingCacheTest : public SignalTest
+{
+public:
+    comp::vector<int> computed;
+    comp::InvalidatingCache<int, int> cache{[this](const int& key)
+    {
+        computed.push_back(key);
+        return key * 10;
+    }};
+};
+
+}
+
+// The cache computes the values once, and recomputes them after they are invalidated.
+TEST_F(InvalidatingCacheTest, computeOnRead)
+{
+    EXPECT_EQ(10, cache.get(1));
+    EXPECT_EQ(10, cache.get(1));
+    EXPECT_TRUE(cache.isCached(1));
+
+    cache.invalidate(1);
+    EXPECT_FALSE(cache.isCached(1));
+    EXPECT_EQ(10, cache.get(1));
+    EXPECT_EQ((comp::vector<int>{1, 1}), computed);
+}
+
+// The activation of a dependency signal invalidates the entries that depend on it.
+TEST_F(InvalidatingCacheTest, invalidateOnActivation)
+{
+    comp::Signal<void()> themeChanged;
+    comp::Signal<void()> localeChanged;
+    cache.dependOn(1, themeChanged);
+    cache.dependOn(2, themeChanged);
+    cache.dependOn(3, localeChanged);
+    cache.get(1);
+    cache.get(2);
+    cache.get(3);
+
+    // The cache connects a single slot to the signal.
+    EXPECT_EQ(1, themeChanged());
+    EXPECT_FALSE(cache.isCached(1));
+    EXPECT_FALSE(cache.isCached(2));
+    EXPECT_TRUE(cache.isCached(3));
+}
+
+// The keyed dependency signal invalidates the entries that depend on the key of the activation.
+TEST_F(InvalidatingCacheTest, invalidateKeyedDependency)
+{
+    comp::Signal<void(int, std::string)> documentChanged;
+    cache.track(documentChanged, [](int document, const std::string&) { return document; });
+    cache.dependOn(1, documentChanged, 100);
+    cache.dependOn(2, documentChanged, 100);
+    cache.dependOn(3, documentChanged, 200);
+    cache.get(1);
+    cache.get(2);
+    cache.get(3);
+
+    documentChanged(200, "title");
+    EXPECT_TRUE(cache.isCached(1));
+    EXPECT_TRUE(cache.isCached(2));
+    EXPECT_FALSE(cache.isCached(3));
+
+    documentChanged(100, "title");
+    EXPECT_FALSE(cache.isCached(1));
+    EXPECT_FALSE(cache.isCached(2));
+}
+
+// The cache drops the index of a deleted dependency signal.
+TEST_F(InvalidatingCacheTest, deleteDependencySignal)
+{
+    auto signal = comp::make_unique<comp::Signal<void()>>();
+    cache.dependOn(1, *signal);
+    cache.get(1);
+    signal.reset();
+
+    EXPECT_TRUE(cache.isCached(1));
+    comp::Signal<void()> other;
+    cache.dependOn(1, other);
+    other();
+    EXPECT_FALSE(cache.isCached(1));
+}
+
+// The keyed dependency of a signal which is not tracked is rejected.
+TEST_F(InvalidatingCacheTest, dependOnUntrackedSignal)
+{
+    comp::Signal<void(int)> signal;
+    EXPECT_THROW(cache.dependOn(1, signal, 100), comp::untracked_signal);
+
+    cache.track(signal, [](int value) { return value; });
+    cache.dependOn(1, signal, 100);
+    cache.get(1);
+    signal(100);
+    EXPECT_FALSE(cache.isCached(1));
+}
+
+// The destroyed cache stops watching its dependency signals.
+TEST_F(InvalidatingCacheTest, deleteCacheBeforeSignal)
+{
+    auto signal = comp::make_unique<comp::Signal<void()>>();
+    {
+        comp::InvalidatingCache<int, int> local([](const int& key) { return key; });
+        local.dependOn(1, *signal);
+    }
+    EXPECT_EQ(0, (*signal)());
+    signal.reset();
+}
+
+// The frozen dependency signal rejects the cache, which keeps no index of it.
+TEST_F(InvalidatingCacheTest, frozenDependencySignal)
+{
+    comp::Signal<void()> signal;
+    signal.freeze();
+    EXPECT_THROW(cache.dependOn(1, signal), comp::frozen_signal);
+
+    signal.thaw();
+    cache.dependOn(1, signal);
+    cache.get(1);
+    EXPECT_EQ(1, signal());
+    EXPECT_FALSE(cache.isCached(1));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <comp/wraps>
+#include <comp/utilities>
 
 namespace
 {
@@ -17,6 +18,19 @@ struct Data
 {
 };
 
+struct Counted : public comp::RefCounted<>
+{
+    explicit Counted(bool& deleted)
+        : deleted(deleted)
+    {
+    }
+    ~Counted()
+    {
+        deleted = true;
+    }
+    bool& deleted;
+};
+
 using UniquePtr = comp::unique_ptr<Data>;
 using UniqueDeleterPtr = comp::unique_ptr<Data, Deleter<Data>>;
 using SharedPtr = comp::shared_ptr<Data>;
@@ -48,6 +62,33 @@ TEST(MemoryTraits, detectWeakPtr)
     EXPECT_TRUE(comp::is_weak_ptr_v<WeakPtr>);
 }
 
+TEST(RefCounted, counterFollowsThreadingPolicy)
+{
+#ifdef COMP_CONFIG_THREAD_ENABLED
+    EXPECT_TRUE((comp::is_same_v<comp::atomic_int, comp::ref_counter>));
+#else
+    EXPECT_TRUE((comp::is_same_v<int, comp::ref_counter>));
+#endif
+}
+
+TEST(RefCounted, intrusivePointerSharesTheObjectCount)
+{
+    bool deleted = false;
+    auto ptr = comp::make_intrusive<Counted>(deleted);
+    EXPECT_EQ(1, ptr.use_count());
+
+    // A pointer created from the raw object shares the count.
+    auto other = comp::intrusive_ptr<Counted>(ptr.get());
+    EXPECT_EQ(2, ptr.use_count());
+    EXPECT_EQ(ptr, other);
+
+    ptr.reset();
+    EXPECT_FALSE(deleted);
+    EXPECT_EQ(1, other.use_count());
+    other.reset();
+    EXPECT_TRUE(deleted);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,130 @@
+#include "test_base.hpp"
+#include <comp/observable.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
+
+namespace
+{
+
+struct State
+{
+    int first = 0;
+    int second = 0;
+    double ratio = 0.0;
+};
+
+using ObservableTest = SignalTest;
+
+}
+
+// The application developer can read the value that was set last.
+TEST_F(ObservableTest, getReturnsLastValue)
+{
+    comp::Observable<State> state(State{1, 2, 0.5});
+    EXPECT_EQ(1, state.get().first);
+    EXPECT_EQ(2, state.get().second);
+
+    state.set(State{3, 4, 1.5});
+    EXPECT_EQ(3, state.get().first);
+    EXPECT_EQ(4, state.get().second);
+    EXPECT_EQ(1.5, state.get().ratio);
+}
+
+// Setting the value emits the changed signal after the value is published.
+TEST_F(ObservableTest, setEmitsChanged)
+{
+    comp::Observable<int> value;
+    int received = 0;
+    auto slot = [&value, &received](const int& newValue)
+    {
+        EXPECT_EQ(newValue, value.get());
+        received = newValue;
+    };
+    value.changed.connect(slot);
+
+    value.set(10);
+    EXPECT_EQ(10, received);
+}
+
+// The value set from a slot of the changed signal is emitted after the running emission.
+TEST_F(ObservableTest, setFromChangedSlot)
+{
+    comp::Observable<int> value;
+    comp::vector<int> received;
+    auto slot = [&value, &received](const int& newValue)
+    {
+        received.push_back(newValue);
+        if (newValue < 3)
+        {
+            value.set(newValue + 1);
+        }
+    };
+    value.changed.connect(slot);
+
+    value.set(1);
+    EXPECT_EQ((comp::vector<int>{1, 2, 3}), received);
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The emissions of the concurrent writers do not overlap, and the last emission carries the final
+// value.
+TEST_F(ObservableTest, concurrentSetEmitsFinalValue)
+{
+    comp::Observable<int> value;
+    comp::vector<int> received;
+    auto slot = [&received](const int& newValue)
+    {
+        received.push_back(newValue);
+    };
+    value.changed.connect(slot);
+
+    auto writer = [&value](int first)
+    {
+        for (auto i = first; i < 20000; i += 2)
+        {
+            value.set(i);
+        }
+    };
+    std::thread writer1(writer, 0);
+    std::thread writer2(writer, 1);
+    writer1.join();
+    writer2.join();
+
+    ASSERT_FALSE(received.empty());
+    EXPECT_EQ(value.get(), received.back());
+}
+
+// Readers get consistent snapshots while a writer publishes.
+TEST_F(ObservableTest, readersGetConsistentSnapshots)
+{
+    comp::Observable<State> state;
+    comp::atomic_bool done = false;
+    comp::atomic_int inconsistent = 0;
+
+    auto reader = [&state, &done, &inconsistent]()
+    {
+        while (!done)
+        {
+            auto snapshot = state.get();
+            if (snapshot.first != snapshot.second)
+            {
+                ++inconsistent;
+            }
+        }
+    };
+    std::thread reader1(reader);
+    std::thread reader2(reader);
+    for (auto i = 1; i <= 100000; ++i)
+    {
+        state.set(State{i, i, 0.0});
+    }
+    done = true;
+    reader1.join();
+    reader2.join();
+
+    EXPECT_EQ(0, inconsistent);
+    EXPECT_EQ(100000, state.get().first);
+}
+#endif
@@ -0,0 +1,240 @@
+#include "test_base.hpp"
+#include <comp/sharded_signal.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
+
+namespace
+{
+
+using ShardedSignalTest = SignalTest;
+
+}
+
+// The sharded signal activates the connected slots like a signal does.
+TEST_F(ShardedSignalTest, activateSlots)
+{
+    comp::ShardedSignal<void(int)> signal(4u);
+    EXPECT_EQ(4u, signal.shardCount());
+
+    signal.connect(&functionWithIntArgument);
+    signal.connect([](int) { ++functionCallCount; });
+
+    EXPECT_EQ(2, signal(10));
+    EXPECT_EQ(10u, intValue);
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// The replica of the shard is refreshed after slots are connected and disconnected.
+TEST_F(ShardedSignalTest, replicaFollowsConnections)
+{
+    comp::ShardedSignal<void()> signal;
+    auto connection = signal.connect(&function);
+    EXPECT_EQ(1, signal());
+
+    signal.connect(&function);
+    EXPECT_EQ(2, signal());
+
+    connection->disconnect();
+    EXPECT_EQ(1, signal());
+
+    EXPECT_EQ(1, signal.disconnect(&function));
+    EXPECT_EQ(0, signal());
+    EXPECT_EQ(4u, functionCallCount);
+}
+
+// The slots connected once are activated once.
+TEST_F(ShardedSignalTest, connectOnce)
+{
+    comp::ShardedSignal<void()> signal;
+    signal.connectOnce(&function);
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(0, signal());
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// The replicas release the slots invalidated without disconnecting.
+TEST_F(ShardedSignalTest, replicaReleasesInvalidatedSlots)
+{
+    comp::ShardedSignal<void()> signal(1u);
+    auto resource = comp::make_shared<int>(0);
+    comp::weak_ptr<int> watcher = resource;
+    signal.connectOnce([resource]() {});
+    resource.reset();
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(0, signal());
+    EXPECT_TRUE(watcher.expired());
+}
+
+// The signal connected to a sharded signal activates the sharded signal through its replicas.
+TEST_F(ShardedSignalTest, activateFromSignal)
+{
+    comp::ShardedSignal<int(int)> sharded;
+    sharded.connect([](int value) { return value * 2; });
+
+    comp::Signal<int(int)> sender;
+    sender.connect(sharded);
+    comp::SignalConceptImpl<int, int>& base = sharded;
+
+    struct Collector
+    {
+        int last = 0;
+        void collect(int& value)
+        {
+            last = value;
+        }
+    } collector;
+    EXPECT_EQ(1, sender.emit(collector, 21));
+    EXPECT_EQ(42, collector.last);
+    EXPECT_EQ(1, base(1));
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The signals connected to a sharded signal activate it concurrently.
+TEST_F(ShardedSignalTest, concurrentActivationFromSignals)
+{
+    comp::ShardedSignal<void()> sharded;
+    comp::atomic_int inside{0};
+    comp::atomic_int maxInside{0};
+    auto slot = [&inside, &maxInside]()
+    {
+        auto count = ++inside;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (inside < 2 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+        auto max = maxInside.load();
+        while (count > max && !maxInside.compare_exchange_weak(max, count))
+        {
+        }
+        --inside;
+    };
+    sharded.connect(slot);
+
+    comp::Signal<void()> sender1;
+    comp::Signal<void()> sender2;
+    sender1.connect(sharded);
+    sender2.connect(sharded);
+
+    std::thread thread1([&sender1]() { sender1(); });
+    std::thread thread2([&sender2]() { sender2(); });
+    thread1.join();
+    thread2.join();
+    EXPECT_EQ(2, maxInside);
+}
+#endif
+
+// The signal rejects the re-activation from its slots.
+TEST_F(ShardedSignalTest, rejectReactivation)
+{
+    comp::ShardedSignal<void()> signal;
+    int reactivation = 0;
+    auto slot = [&signal, &reactivation]()
+    {
+        reactivation = signal();
+    };
+    signal.connect(slot);
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(-1, reactivation);
+}
+
+// The collector of the emit collects the slot results.
+TEST_F(ShardedSignalTest, emitWithCollector)
+{
+    struct Collector
+    {
+        int sum = 0;
+        void collect(int& value)
+        {
+            sum += value;
+        }
+    };
+    comp::ShardedSignal<int()> signal;
+    signal.connect(&intFunction);
+    signal.connect(&intFunction);
+
+    Collector collector;
+    EXPECT_EQ(2, signal.emit(collector));
+    EXPECT_EQ(2 * 1337, collector.sum);
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// Threads activate the signal concurrently while slots are connected.
+TEST_F(ShardedSignalTest, concurrentActivation)
+{
+    comp::ShardedSignal<void(int)> signal(4u);
+    comp::atomic_int sum = 0;
+    signal.connect([&sum](int value) { sum += value; });
+
+    auto emitter = [&signal]()
+    {
+        for (auto i = 0; i < 10000; ++i)
+        {
+            EXPECT_LE(1, signal(1));
+        }
+    };
+    std::thread thread1(emitter);
+    std::thread thread2(emitter);
+    std::thread thread3(emitter);
+    for (auto i = 0; i < 10; ++i)
+    {
+        signal.connect([](int) {});
+    }
+    thread1.join();
+    thread2.join();
+    thread3.join();
+
+    EXPECT_EQ(30000, sum);
+    EXPECT_EQ(11, signal(0));
+}
+#endif
+
+// The activations from the replicas are not counted on the connection, the slot can disconnect
+// itself, and wait.
+TEST_F(ShardedSignalTest, disconnectAndWaitFromSlot)
+{
+    comp::ShardedSignal<void()> signal;
+    bool wasActive = true;
+    auto slot = [&wasActive](comp::ConnectionPtr connection)
+    {
+        wasActive = connection->isActive();
+        connection->disconnectAndWait();
+    };
+    auto connection = signal.connect(slot);
+
+    EXPECT_EQ(1, signal());
+    EXPECT_FALSE(wasActive);
+    EXPECT_FALSE(connection->isValid());
+    EXPECT_EQ(0, signal());
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The disconnectAndWait() waits for the activation running from a replica on an other thread.
+TEST_F(ShardedSignalTest, disconnectAndWaitForReplicaActivation)
+{
+    comp::ShardedSignal<void()> signal;
+    comp::atomic_bool entered = false;
+    comp::atomic_bool completed = false;
+    auto slot = [&entered, &completed]()
+    {
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        completed = true;
+    };
+    auto connection = signal.connect(slot);
+
+    std::thread emitter([&signal]() { signal(); });
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+    connection->disconnectAndWait();
+    EXPECT_TRUE(completed);
+    emitter.join();
+}
+#endif
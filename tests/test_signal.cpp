@@ -1,4 +1,9 @@
 #include "test_base.hpp"
+#include <stdexcept>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
 
 namespace
 {
@@ -16,6 +21,11 @@ public:
         connection->disconnect();
     }
 
+    void autoDisconnectRef(comp::ConnectionRef connection)
+    {
+        connection->disconnect();
+    }
+
     size_t methodCallCount = 0u;
 };
 
@@ -211,6 +221,118 @@ TEST_F(SignalTest, disconnectWithSignal)
     EXPECT_EQ(0u, signal());
 }
 
+// The application developer can connect slots that take a non-owning connection reference.
+TEST_F(SignalTest, disconnectWithConnectionRef)
+{
+    comp::Signal<void(int)> signal;
+    auto connection = comp::ConnectionPtr();
+    auto useCount = 0;
+    auto slot = [&connection, &useCount](comp::ConnectionRef self, int value)
+    {
+        // The reference does not retain the connection.
+        useCount = connection.use_count();
+        EXPECT_EQ(connection.get(), &*self);
+        intValue = value;
+        self->disconnect();
+    };
+    connection = signal.connect(slot);
+    const auto expectedUseCount = connection.use_count() + 1;
+
+    EXPECT_EQ(1, signal(7));
+    EXPECT_EQ(expectedUseCount, useCount);
+    EXPECT_EQ(7u, intValue);
+    EXPECT_FALSE(connection->isValid());
+
+    comp::Signal<void()> voidSignal;
+    auto object = comp::make_shared<Object1>();
+    auto methodConnection = voidSignal.connect(object, &Object1::autoDisconnectRef);
+    EXPECT_EQ(1, voidSignal());
+    EXPECT_FALSE(methodConnection->isValid());
+}
+
+// The connection is shared between the signal and the application developer.
+TEST_F(SignalTest, connectionReferences)
+{
+    comp::Signal<void()> signal;
+    auto connection = signal.connect(&function);
+    EXPECT_EQ(2, connection.use_count());
+
+    connection->disconnect();
+    EXPECT_EQ(1, connection.use_count());
+}
+
+// The application developer can connect a slot that is activated only once.
+TEST_F(SignalTest, connectOnce)
+{
+    comp::Signal<void(int)> signal;
+    auto connection = signal.connectOnce(&functionWithIntArgument);
+    EXPECT_TRUE(connection->isValid());
+
+    EXPECT_EQ(1, signal(10));
+    EXPECT_EQ(10, intValue);
+    EXPECT_FALSE(connection->isValid());
+
+    EXPECT_EQ(0, signal(20));
+    EXPECT_EQ(10, intValue);
+}
+
+// The one-shot connection is dropped by the next signal activation, without being removed when it fires.
+TEST_F(SignalTest, connectOnceIsDroppedLazily)
+{
+    comp::Signal<void()> signal;
+    auto connection = signal.connectOnce([]() {});
+    signal.connect(&function);
+
+    EXPECT_EQ(2, signal());
+    EXPECT_EQ(2, connection.use_count());
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(1, connection.use_count());
+    EXPECT_EQ(2u, functionCallCount);
+}
+
+// The application developer can disconnect a function without holding its connection.
+TEST_F(SignalTest, disconnectFunction)
+{
+    comp::Signal<void(int)> signal;
+    auto connection = signal.connect(&functionWithIntArgument);
+    signal.connect(&functionWithIntArgument);
+    signal.connect([](int) {});
+
+    EXPECT_EQ(2, signal.disconnect(&functionWithIntArgument));
+    EXPECT_FALSE(connection->isValid());
+    EXPECT_EQ(0, signal.disconnect(&functionWithIntArgument));
+    EXPECT_EQ(1, signal(10));
+    EXPECT_EQ(0u, intValue);
+}
+
+// The application developer can disconnect a method of a receiver without holding its connection.
+TEST_F(SignalTest, disconnectMethod)
+{
+    comp::Signal<void()> signal;
+    auto object1 = comp::make_shared<Object1>();
+    auto object2 = comp::make_shared<Object1>();
+    signal.connect(object1, &Object1::methodWithNoArg);
+    auto connection = signal.connect(object2, &Object1::methodWithNoArg);
+
+    EXPECT_EQ(1, signal.disconnect(object1, &Object1::methodWithNoArg));
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(0u, object1->methodCallCount);
+    EXPECT_EQ(1u, object2->methodCallCount);
+    EXPECT_TRUE(connection->isValid());
+}
+
+// The application developer can disconnect a receiver signal without holding its connection.
+TEST_F(SignalTest, disconnectReceiverSignal)
+{
+    comp::Signal<void()> sender;
+    comp::Signal<void()> receiver;
+    auto connection = sender.connect(receiver);
+
+    EXPECT_EQ(1, sender.disconnect(receiver));
+    EXPECT_FALSE(connection->isValid());
+    EXPECT_EQ(0, sender());
+}
+
 // The application developer can connect the same function multiple times.
 TEST_F(SignalTest, connectFunctionManyTimes)
 {
@@ -247,6 +369,552 @@ TEST_F(SignalTest, connectLambdaManyTimes)
     EXPECT_EQ(invokeCount, signal());
 }
 
+// In unique connection mode, the same function is connected only once.
+TEST_F(SignalTest, uniqueConnectFunction)
+{
+    comp::Signal<void()> signal;
+    signal.setUniqueConnections(true);
+    auto connection = signal.connect(&function);
+    EXPECT_EQ(connection, signal.connect(&function));
+
+    // Lambdas have no identity, those are connected each time.
+    auto lambda = []() {};
+    EXPECT_NE(signal.connect(lambda), signal.connect(lambda));
+
+    EXPECT_EQ(3, signal());
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// In unique connection mode, the same method of a receiver is connected only once.
+TEST_F(SignalTest, uniqueConnectMethod)
+{
+    comp::Signal<void()> signal;
+    signal.setUniqueConnections(true);
+    auto object1 = comp::make_shared<Object1>();
+    auto object2 = comp::make_shared<Object1>();
+    auto connection = signal.connect(object1, &Object1::methodWithNoArg);
+    EXPECT_EQ(connection, signal.connect(object1, &Object1::methodWithNoArg));
+    EXPECT_NE(connection, signal.connect(object2, &Object1::methodWithNoArg));
+
+    EXPECT_EQ(2, signal());
+    EXPECT_EQ(1u, object1->methodCallCount);
+    EXPECT_EQ(1u, object2->methodCallCount);
+}
+
+// In unique connection mode, connecting a connected slot with an other priority moves the slot.
+TEST_F(SignalTest, uniqueConnectWithOtherPriority)
+{
+    comp::Signal<void()> signal;
+    signal.setUniqueConnections(true);
+    comp::vector<int> invocations;
+    signal.connect(5, [&invocations]() { invocations.push_back(5); });
+    auto connection = signal.connect(&function);
+    signal.connect(1, [&invocations]() { invocations.push_back(1); });
+    auto record = [&invocations]()
+    {
+        invocations.push_back(functionCallCount);
+    };
+    signal.connect(-1, record);
+
+    EXPECT_EQ(connection, signal.connect(3, &function));
+    EXPECT_EQ(3, connection->priority());
+    EXPECT_EQ(4, signal());
+    EXPECT_EQ((comp::vector<int>{5, 1, 1}), invocations);
+
+    invocations.clear();
+    EXPECT_EQ(connection, signal.connect(-2, &function));
+    EXPECT_EQ(4, signal());
+    EXPECT_EQ((comp::vector<int>{5, 1, 1}), invocations);
+    EXPECT_EQ(2u, functionCallCount);
+}
+
+// In unique connection mode, a disconnected slot can be connected again.
+TEST_F(SignalTest, uniqueConnectAfterDisconnect)
+{
+    comp::Signal<void()> signal;
+    signal.setUniqueConnections(true);
+    auto connection = signal.connect(&function);
+    connection->disconnect();
+
+    auto reconnection = signal.connect(&function);
+    EXPECT_NE(connection, reconnection);
+    EXPECT_TRUE(reconnection->isValid());
+    EXPECT_EQ(1, signal());
+}
+
+// In unique connection mode, a connection to a destroyed receiver does not block connecting a new receiver.
+TEST_F(SignalTest, uniqueConnectAfterReceiverExpired)
+{
+    struct Receiver : public comp::enable_shared_from_this<Receiver>
+    {
+        void method()
+        {
+            ++functionCallCount;
+        }
+    };
+    comp::Signal<void()> signal;
+    signal.setUniqueConnections(true);
+    auto object = comp::make_shared<Receiver>();
+    auto connection = signal.connect(object, &Receiver::method);
+    object.reset();
+
+    object = comp::make_shared<Receiver>();
+    EXPECT_NE(connection, signal.connect(object, &Receiver::method));
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// The application developer can connect slots with priority. Slots with higher priority are activated first,
+// slots with the same priority are activated in connection order.
+TEST_F(SignalTest, connectWithPriority)
+{
+    comp::Signal<void()> signal;
+    comp::vector<int> order;
+    auto object = comp::make_shared<Object1>();
+
+    signal.connect([&order]() { order.push_back(1); });
+    signal.connect(10, [&order]() { order.push_back(2); });
+    signal.connect(-5, [&order]() { order.push_back(3); });
+    signal.connect(10, [&order]() { order.push_back(4); });
+    signal.connect([&order]() { order.push_back(5); });
+    auto connection = signal.connect(20, object, &Object1::methodWithNoArg);
+    EXPECT_EQ(20, connection->priority());
+
+    EXPECT_EQ(6, signal());
+    EXPECT_EQ((comp::vector<int>{2, 4, 1, 5, 3}), order);
+    EXPECT_EQ(1u, object->methodCallCount);
+}
+
+// The application developer can reserve the storage of the connections, and release it.
+TEST_F(SignalTest, reserveAndShrinkStorage)
+{
+    comp::Signal<void()> signal;
+    signal.reserve(100u);
+    EXPECT_LE(100u, signal.capacity());
+
+    signal.connect(&function);
+    signal.shrinkToFit();
+    EXPECT_EQ(1u, signal.capacity());
+    EXPECT_EQ(1, signal());
+}
+
+// The signal releases the unused storage after a burst of connections is disconnected.
+TEST_F(SignalTest, autoShrinkAfterBurst)
+{
+    comp::Signal<void()> signal;
+    EXPECT_TRUE(signal.hasAutoShrink());
+    signal.connect(&function);
+
+    comp::vector<comp::ConnectionPtr> burst;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        burst.push_back(signal.connectOnce([]() {}));
+    }
+    EXPECT_LE(1001u, signal.capacity());
+
+    EXPECT_EQ(1001, signal());
+    EXPECT_EQ(1, signal());
+    EXPECT_GT(64u, signal.capacity());
+
+    // Disabled shrink keeps the storage.
+    signal.setAutoShrink(false);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        signal.connectOnce([]() {});
+    }
+    signal();
+    signal();
+    EXPECT_LE(1001u, signal.capacity());
+}
+
+// The application developer can query the memory used by a signal, and by the slots of all signals.
+TEST_F(SignalTest, memoryUsage)
+{
+    const auto before = comp::memoryUsage();
+    const auto functionIndex = static_cast<size_t>(comp::SlotClass::Function);
+    const auto methodIndex = static_cast<size_t>(comp::SlotClass::Method);
+    {
+        comp::Signal<void()> signal;
+        EXPECT_EQ(0u, signal.bytesUsed());
+
+        auto object = comp::make_shared<Object1>();
+        signal.connect(&function);
+        signal.connect([]() {});
+        signal.connect(object, &Object1::methodWithNoArg);
+
+        auto usage = signal.memoryUsage();
+        EXPECT_EQ(2u, usage.slotCount[functionIndex]);
+        EXPECT_EQ(1u, usage.slotCount[methodIndex]);
+        EXPECT_LT(0u, usage.slotBytes[methodIndex]);
+        EXPECT_LE(3u * sizeof(comp::ConnectionPtr), usage.containers);
+        EXPECT_EQ(usage.total(), signal.bytesUsed());
+
+        const auto global = comp::memoryUsage();
+        EXPECT_EQ(before.slotCount[functionIndex] + 2u, global.slotCount[functionIndex]);
+        EXPECT_EQ(before.slotBytes[methodIndex] + usage.slotBytes[methodIndex], global.slotBytes[methodIndex]);
+    }
+
+    const auto after = comp::memoryUsage();
+    EXPECT_EQ(before.slots(), after.slots());
+}
+
+// The unordered signal replaces the disconnected slots with the last slot, and keeps activating the rest.
+TEST_F(SignalTest, unorderedConnectionsDisconnect)
+{
+    comp::Signal<void(int)> signal;
+    signal.setUnorderedConnections(true);
+    EXPECT_TRUE(signal.hasUnorderedConnections());
+
+    comp::vector<int> invocations;
+    comp::vector<comp::ConnectionPtr> connections;
+    for (auto i = 0; i < 6; ++i)
+    {
+        connections.push_back(signal.connect([&invocations, i](int) { invocations.push_back(i); }));
+    }
+
+    signal.disconnect(*connections[1]);
+    connections[3]->disconnect();
+    EXPECT_EQ(4, signal(0));
+    comp::sort(invocations.begin(), invocations.end());
+    EXPECT_EQ((comp::vector<int>{0, 2, 4, 5}), invocations);
+}
+
+// Regrouping an unordered signal activates the slots of the same class one after the other.
+TEST_F(SignalTest, unorderedConnectionsRegroup)
+{
+    comp::Signal<void()> signal;
+    comp::vector<char> order;
+    auto slotA = [&order]() { order.push_back('a'); };
+    auto slotB = [&order]() { order.push_back('b'); };
+    signal.connect(slotA);
+    signal.connect(slotB);
+    signal.connect(slotA);
+    signal.connect(slotB);
+
+    signal.setUnorderedConnections(true);
+    EXPECT_EQ(4, signal());
+    ASSERT_EQ(4u, order.size());
+    EXPECT_EQ(order[0], order[1]);
+    EXPECT_EQ(order[2], order[3]);
+    EXPECT_NE(order[1], order[2]);
+}
+
+// The frozen signal activates its slots, and rejects new connections until thawed.
+TEST_F(SignalTest, freezeSignal)
+{
+    comp::Signal<void(int)> signal;
+    signal.connect(&functionWithIntArgument);
+    auto connection = signal.connect([](int) {});
+    signal.freeze();
+    EXPECT_TRUE(signal.isFrozen());
+
+    EXPECT_EQ(2, signal(10));
+    EXPECT_EQ(10, intValue);
+    EXPECT_THROW(signal.connect([](int) {}), comp::frozen_signal);
+
+    // The disconnected slot is skipped.
+    connection->disconnect();
+    EXPECT_EQ(1, signal(20));
+
+    signal.thaw();
+    EXPECT_FALSE(signal.isFrozen());
+    signal.connect([](int) {});
+    EXPECT_EQ(2, signal(30));
+}
+
+// The frozen signal can be thawed from its own slot.
+TEST_F(SignalTest, thawFromSlot)
+{
+    comp::Signal<void()> signal;
+    auto thaw = [&signal]()
+    {
+        signal.thaw();
+        signal.connect(&function);
+    };
+    signal.connect(thaw);
+    signal.freeze();
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(0u, functionCallCount);
+    EXPECT_FALSE(signal.isFrozen());
+}
+
+// The frozen signal can be refrozen from its own slot, the new connections are compacted when the
+// activation completes.
+TEST_F(SignalTest, freezeFromSlot)
+{
+    comp::Signal<void()> signal;
+    auto refreeze = [&signal](comp::ConnectionPtr connection)
+    {
+        signal.thaw();
+        signal.connect(&function);
+        connection->disconnect();
+        signal.freeze();
+        EXPECT_TRUE(signal.isFrozen());
+    };
+    signal.connect(refreeze);
+    signal.freeze();
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(0u, functionCallCount);
+    EXPECT_TRUE(signal.isFrozen());
+    EXPECT_THROW(signal.connect(&function), comp::frozen_signal);
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// The signal replaces its slots in a single swap.
+TEST_F(SignalTest, replaceSlots)
+{
+    comp::Signal<void(int)> signal;
+    auto oldConnection = signal.connect(&functionWithIntArgument);
+    signal.connect([](int) {});
+
+    comp::vector<int> invocations;
+    auto builder = [&invocations](auto& staging)
+    {
+        staging.connect([&invocations](int value) { invocations.push_back(value); });
+        staging.connect(10, [&invocations](int value) { invocations.push_back(-value); });
+    };
+    signal.replaceSlots(builder);
+    EXPECT_FALSE(oldConnection->isValid());
+
+    EXPECT_EQ(2, signal(5));
+    EXPECT_EQ(0, intValue);
+    EXPECT_EQ((comp::vector<int>{-5, 5}), invocations);
+}
+
+// The slot replacing the slots of the signal it is activated from does not cut the activation, the
+// replaced slots are retired after the activation completes.
+TEST_F(SignalTest, replaceSlotsFromSlot)
+{
+    comp::Signal<void()> signal;
+    comp::vector<int> invocations;
+    auto replace = [&signal, &invocations]()
+    {
+        invocations.push_back(1);
+        signal.replaceSlots([&invocations](auto& staging) { staging.connect([&invocations]() { invocations.push_back(3); }); });
+    };
+    signal.connect(replace);
+    auto oldConnection = signal.connect([&invocations]() { invocations.push_back(2); });
+
+    EXPECT_EQ(2, signal());
+    EXPECT_EQ((comp::vector<int>{1, 2}), invocations);
+    EXPECT_FALSE(oldConnection->isValid());
+
+    invocations.clear();
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ((comp::vector<int>{3}), invocations);
+}
+
+// The slots published by the replace disconnect from the signal that holds them.
+TEST_F(SignalTest, disconnectReplacedSlot)
+{
+    comp::Signal<void()> signal;
+    comp::ConnectionPtr connection;
+    signal.replaceSlots([&connection](auto& staging) { connection = staging.connect(&function); });
+    EXPECT_TRUE(connection->isValid());
+
+    connection->disconnect();
+    EXPECT_EQ(0, signal());
+    EXPECT_EQ(0u, functionCallCount);
+}
+
+// The memoized slot is invoked only when the arguments change.
+TEST_F(SignalTest, connectMemoized)
+{
+    comp::Signal<void(int, std::string)> signal;
+    auto invocations = 0;
+    signal.connectMemoized([&invocations](int, std::string) { ++invocations; });
+
+    EXPECT_EQ(1, signal(1, "one"));
+    EXPECT_EQ(0, signal(1, "one"));
+    EXPECT_EQ(1, signal(2, "one"));
+    EXPECT_EQ(1, signal(2, "two"));
+    EXPECT_EQ(0, signal(2, "two"));
+    EXPECT_EQ(3, invocations);
+}
+
+// The memoized slot returning a value gives the last result when the arguments repeat.
+TEST_F(SignalTest, connectMemoizedWithResult)
+{
+    comp::Signal<int(int)> signal;
+    auto invocations = 0;
+    signal.connectMemoized([&invocations](int value) { ++invocations; return value * value; });
+
+    struct Results : comp::vector<int>
+    {
+        void collect(int result)
+        {
+            push_back(result);
+        }
+    } results;
+    EXPECT_EQ(1, signal.emit(results, 3));
+    EXPECT_EQ(0, signal.emit(results, 3));
+    EXPECT_EQ(1, signal.emit(results, 4));
+    EXPECT_EQ(2, invocations);
+    EXPECT_EQ((comp::vector<int>{9, 9, 16}), results);
+}
+
+// The memoized slot can compare the hash of the arguments.
+TEST_F(SignalTest, connectMemoizedWithHash)
+{
+    comp::Signal<void(int)> signal;
+    auto invocations = 0;
+    auto parity = [](int value) { return static_cast<size_t>(value % 2); };
+    signal.connectMemoized([&invocations](int) { ++invocations; }, parity);
+
+    EXPECT_EQ(1, signal(1));
+    EXPECT_EQ(0, signal(3));
+    EXPECT_EQ(1, signal(4));
+    EXPECT_EQ(0, signal(6));
+    EXPECT_EQ(1, signal(7));
+    EXPECT_EQ(3, invocations);
+}
+
+// The memoized slot remembers the arguments only when the invocation succeeds.
+TEST_F(SignalTest, connectMemoizedWithThrowingSlot)
+{
+    comp::Signal<void(int)> signal;
+    auto invocations = 0;
+    auto fails = true;
+    auto slot = [&invocations, &fails](int)
+    {
+        ++invocations;
+        if (fails)
+        {
+            throw std::runtime_error("failed");
+        }
+    };
+    signal.connectMemoized(slot);
+
+    EXPECT_THROW(signal(1), std::runtime_error);
+    fails = false;
+    EXPECT_EQ(1, signal(1));
+    EXPECT_EQ(0, signal(1));
+    EXPECT_EQ(2, invocations);
+}
+
+// The application developer can disconnect a slot from the slot itself, and wait for the activation.
+TEST_F(SignalTest, disconnectAndWaitFromSlot)
+{
+    comp::Signal<void()> signal;
+    bool wasActive = false;
+    auto slot = [&wasActive](comp::ConnectionPtr connection)
+    {
+        wasActive = connection->isActive();
+        connection->disconnectAndWait();
+    };
+    auto connection = signal.connect(slot);
+    EXPECT_FALSE(connection->isActive());
+
+    EXPECT_EQ(1, signal());
+    EXPECT_TRUE(wasActive);
+    EXPECT_FALSE(connection->isValid());
+    EXPECT_FALSE(connection->isActive());
+    EXPECT_EQ(0, signal());
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The disconnectAndWait() returns when the activation of the slot on an other thread completes.
+TEST_F(SignalTest, disconnectAndWaitForOtherThread)
+{
+    comp::Signal<void()> signal;
+    comp::atomic_bool entered = false;
+    comp::atomic_bool completed = false;
+    auto slot = [&entered, &completed]()
+    {
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        completed = true;
+    };
+    auto connection = signal.connect(slot);
+
+    std::thread emitter([&signal]() { signal(); });
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+    connection->disconnectAndWait();
+    EXPECT_TRUE(completed);
+    emitter.join();
+}
+#endif
+
+// The application developer can connect a slot that receives the activations in batches.
+TEST_F(SignalTest, connectBatched)
+{
+    comp::Signal<void(int, std::string)> signal;
+    comp::vector<size_t> batchSizes;
+    comp::vector<std::string> strings;
+    auto slot = [&batchSizes, &strings](comp::span<const std::tuple<int, std::string>> batch)
+    {
+        batchSizes.push_back(batch.size());
+        for (auto& arguments : batch)
+        {
+            strings.push_back(std::get<1>(arguments));
+        }
+    };
+    auto connection = signal.connectBatched(slot, 3u, std::chrono::hours(1));
+
+    signal(1, "one");
+    signal(2, "two");
+    EXPECT_TRUE(batchSizes.empty());
+    signal(3, "three");
+    EXPECT_EQ(comp::vector<size_t>({3u}), batchSizes);
+
+    // Flushing delivers the pending batch.
+    signal(4, "four");
+    signal.flush();
+    EXPECT_EQ(comp::vector<size_t>({3u, 1u}), batchSizes);
+    EXPECT_EQ(comp::vector<std::string>({"one", "two", "three", "four"}), strings);
+
+    connection->flush();
+    EXPECT_EQ(2u, batchSizes.size());
+}
+
+// The pending batch is delivered when the connection disconnects.
+TEST_F(SignalTest, disconnectBatched)
+{
+    comp::vector<int> values;
+    auto slot = [&values](comp::span<const int> batch)
+    {
+        values.insert(values.end(), batch.begin(), batch.end());
+    };
+    {
+        comp::Signal<void(int)> signal;
+        auto connection = signal.connectBatched(slot, 10u, std::chrono::hours(1));
+        signal(1);
+        signal(2);
+        signal(3);
+        connection->disconnect();
+        EXPECT_EQ(comp::vector<int>({1, 2, 3}), values);
+
+        signal.connectBatched(slot, 10u, std::chrono::hours(1));
+        signal(4);
+    }
+    // The destroyed signal disconnects the connection.
+    EXPECT_EQ(comp::vector<int>({1, 2, 3, 4}), values);
+}
+
+// The batch is delivered on the first activation after the delay elapses.
+TEST_F(SignalTest, connectBatchedWithDelay)
+{
+    comp::Signal<void(int)> signal;
+    comp::vector<int> values;
+    auto slot = [&values](comp::span<const int> batch)
+    {
+        values.insert(values.end(), batch.begin(), batch.end());
+    };
+    signal.connectBatched(slot, 100u, std::chrono::nanoseconds(0));
+
+    signal(1);
+    EXPECT_EQ(comp::vector<int>({1}), values);
+    signal(2);
+    EXPECT_EQ(comp::vector<int>({1, 2}), values);
+}
+
 // The application developer can connect the activated signal to a slot from an activated slot.
 TEST_F(SignalTest, connectToTheInvokingSignal)
 {
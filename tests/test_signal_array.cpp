@@ -0,0 +1,106 @@
+#include "test_base.hpp"
+#include <comp/signal_array.hpp>
+
+namespace
+{
+
+using SignalArrayTest = SignalTest;
+
+}
+
+// The signals of the array are activated one by one, or in bulk.
+TEST_F(SignalArrayTest, emitSubset)
+{
+    comp::SignalArray<void(int)> signals(4u);
+    EXPECT_EQ(4u, signals.size());
+
+    comp::vector<int> activations;
+    for (auto i = 0; i < 4; ++i)
+    {
+        signals[i].connect([&activations, i](int value) { activations.push_back(i * 100 + value); });
+    }
+
+    EXPECT_EQ(1, signals[1](5));
+    EXPECT_EQ(comp::vector<int>({105}), activations);
+
+    activations.clear();
+    const size_t indexes[] = {3u, 0u, 2u};
+    EXPECT_EQ(3, signals.emit(indexes, 7));
+    EXPECT_EQ(comp::vector<int>({307, 7, 207}), activations);
+}
+
+// The repeated indexes and the blocked signals are skipped.
+TEST_F(SignalArrayTest, skipRepeatedAndBlocked)
+{
+    comp::SignalArray<void()> signals(3u);
+    for (auto i = 0u; i < signals.size(); ++i)
+    {
+        signals[i].connect([]() { ++functionCallCount; });
+    }
+    signals[2].setBlocked(true);
+
+    const comp::vector<size_t> indexes = {0u, 1u, 0u, 2u, 1u};
+    EXPECT_EQ(2, signals.emit(indexes));
+    EXPECT_EQ(2u, functionCallCount);
+
+    // The guards are released after the bulk activation.
+    EXPECT_EQ(1, signals[0]());
+}
+
+// The function connected to several signals of the subset is activated once.
+TEST_F(SignalArrayTest, activateSharedSlotOnce)
+{
+    comp::SignalArray<void()> signals(3u);
+    comp::vector<int> activations;
+    for (auto i = 0; i < 3; ++i)
+    {
+        signals[i].connect(&function);
+        signals[i].connect([&activations, i]() { activations.push_back(i); });
+    }
+
+    const size_t indexes[] = {2u, 0u, 1u};
+    EXPECT_EQ(4, signals.emit(indexes));
+    EXPECT_EQ(1u, functionCallCount);
+    EXPECT_EQ(comp::vector<int>({2, 0, 1}), activations);
+
+    // The slot connected twice to the same signal is activated with both connections.
+    signals[2].connect(&function);
+    EXPECT_EQ(5, signals.emit(indexes));
+    EXPECT_EQ(3u, functionCallCount);
+}
+
+// The slots of the signals activated in bulk cannot re-activate the signals.
+TEST_F(SignalArrayTest, rejectReactivation)
+{
+    comp::SignalArray<void()> signals(2u);
+    int reactivation = 0;
+    signals[0].connect([&signals, &reactivation]() { reactivation = signals[1](); });
+    signals[1].connect(&function);
+
+    const size_t indexes[] = {0u, 1u};
+    EXPECT_EQ(2, signals.emit(indexes));
+    EXPECT_EQ(-1, reactivation);
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// The collector collects the results of the slots of all the signals.
+TEST_F(SignalArrayTest, emitWithCollector)
+{
+    struct Collector
+    {
+        int count = 0;
+        void collect(int&)
+        {
+            ++count;
+        }
+    };
+    comp::SignalArray<int()> signals(2u);
+    signals[0].connect(&intFunction);
+    signals[1].connect([]() { return 1; });
+    signals[1].connect([]() { return 2; });
+
+    Collector collector;
+    const size_t indexes[] = {0u, 1u};
+    EXPECT_EQ(3, signals.emit(collector, indexes));
+    EXPECT_EQ(3, collector.count);
+}
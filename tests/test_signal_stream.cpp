@@ -0,0 +1,117 @@
+#include "test_base.hpp"
+#include <comp/signal_stream.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
+
+namespace
+{
+
+using SignalStreamTest = SignalTest;
+
+}
+
+// The stream reads the buffered activations in batches, in the order of the activation.
+TEST_F(SignalStreamTest, readInBatches)
+{
+    comp::Signal<void(int)> signal;
+    comp::SignalStream<void(int)> stream(signal, 8u);
+    EXPECT_EQ(8u, stream.capacity());
+
+    for (auto i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(1, signal(i));
+    }
+    EXPECT_EQ(5u, stream.size());
+
+    int batch[3] = {};
+    EXPECT_EQ(3u, stream.read(batch));
+    EXPECT_EQ(0, batch[0]);
+    EXPECT_EQ(2, batch[2]);
+
+    EXPECT_EQ(2u, stream.read(batch));
+    EXPECT_EQ(3, batch[0]);
+    EXPECT_EQ(4, batch[1]);
+    EXPECT_EQ(0u, stream.read(batch));
+}
+
+// The stream drops the activations when the ring is full, and keeps the buffered ones.
+TEST_F(SignalStreamTest, dropWhenFull)
+{
+    comp::Signal<void(int, std::string)> signal;
+    comp::SignalStream<void(int, std::string)> stream(signal, 2u);
+
+    signal(1, "one");
+    signal(2, "two");
+    signal(3, "three");
+    EXPECT_EQ(1u, stream.droppedCount());
+
+    comp::vector<std::tuple<int, std::string>> batch(4u);
+    EXPECT_EQ(2u, stream.read(batch));
+    EXPECT_EQ("one", std::get<1>(batch[0]));
+    EXPECT_EQ("two", std::get<1>(batch[1]));
+
+    // The ring wraps around.
+    signal(4, "four");
+    EXPECT_EQ(1u, stream.read(batch));
+    EXPECT_EQ(4, std::get<0>(batch[0]));
+}
+
+// The destroyed stream unsubscribes from the signal.
+TEST_F(SignalStreamTest, destroyedStreamUnsubscribes)
+{
+    comp::Signal<void(int)> signal;
+    {
+        comp::SignalStream<void(int)> stream(signal, 2u);
+        EXPECT_EQ(1, signal(1));
+    }
+    EXPECT_EQ(0, signal(2));
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The consumer is woken up when a batch is complete.
+TEST_F(SignalStreamTest, waitForBatch)
+{
+    comp::Signal<void(int)> signal;
+    comp::SignalStream<void(int)> stream(signal, 64u);
+    EXPECT_FALSE(stream.waitFor(1u, std::chrono::milliseconds(1)));
+
+    std::thread producer([&signal]()
+    {
+        for (auto i = 0; i < 32; ++i)
+        {
+            signal(i);
+        }
+    });
+    EXPECT_TRUE(stream.waitFor(32u, std::chrono::seconds(10)));
+    producer.join();
+
+    comp::vector<int> batch(32u);
+    EXPECT_EQ(32u, stream.read(batch));
+    EXPECT_EQ(31, batch[31]);
+}
+
+// The consumers waiting for different batch sizes are each woken up when their batch is complete.
+TEST_F(SignalStreamTest, concurrentWaitersWithDifferentBatches)
+{
+    comp::Signal<void(int)> signal;
+    comp::SignalStream<void(int)> stream(signal, 64u);
+
+    comp::atomic_bool smallReady = false;
+    comp::atomic_bool largeReady = false;
+    std::thread small([&]() { smallReady = stream.waitFor(4u, std::chrono::seconds(10)); });
+    std::thread large([&]() { largeReady = stream.waitFor(16u, std::chrono::seconds(10)); });
+    // Let the consumers register their batch sizes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    for (auto i = 0; i < 16; ++i)
+    {
+        signal(i);
+    }
+    small.join();
+    large.join();
+    EXPECT_TRUE(smallReady);
+    EXPECT_TRUE(largeReady);
+}
+#endif
@@ -0,0 +1,124 @@
+#include "test_base.hpp"
+#include <comp/signal_waiter.hpp>
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
+
+namespace
+{
+
+using SignalWaiterTest = SignalTest;
+
+}
+
+// The any-waiter gets ready with the arguments of the first signal activated.
+TEST_F(SignalWaiterTest, whenAnyDeliversFirstActivation)
+{
+    comp::Signal<void(int)> intSignal;
+    comp::Signal<void(std::string, int)> stringSignal;
+    auto waiter = comp::when_any(intSignal, stringSignal);
+    EXPECT_FALSE(waiter.isReady());
+
+    EXPECT_EQ(1, stringSignal("alpha", 10));
+    EXPECT_TRUE(waiter.isReady());
+    EXPECT_EQ(1u, waiter.index());
+    EXPECT_EQ("alpha", std::get<0>(waiter.get<1>()));
+    EXPECT_EQ(10, std::get<1>(waiter.get<1>()));
+
+    // The later activations do not change the result, and the temporary slots are dropped.
+    EXPECT_EQ(0, intSignal(20));
+    EXPECT_EQ(0, stringSignal("beta", 20));
+    EXPECT_EQ(1u, waiter.index());
+}
+
+// The any-waiter disconnects its slots from the signals which were not activated.
+TEST_F(SignalWaiterTest, whenAnyDisconnectsSlots)
+{
+    comp::Signal<void(int)> signal1;
+    comp::Signal<void(int)> signal2;
+    const auto other = static_cast<size_t>(comp::SlotClass::Other);
+    auto waiter = comp::when_any(signal1, signal2);
+    EXPECT_EQ(1u, signal2.memoryUsage().slotCount[other]);
+
+    EXPECT_EQ(1, signal1(1));
+    EXPECT_TRUE(waiter.isReady());
+    EXPECT_EQ(0u, signal1.memoryUsage().slotCount[other]);
+    EXPECT_EQ(0u, signal2.memoryUsage().slotCount[other]);
+}
+
+// The all-waiter gets ready when each signal was activated, and keeps the first arguments of each.
+TEST_F(SignalWaiterTest, whenAllDeliversEachActivation)
+{
+    comp::Signal<void(int)> signal1;
+    comp::Signal<void(int)> signal2;
+    auto waiter = comp::when_all(signal1, signal2);
+
+    EXPECT_EQ(1, signal1(1));
+    EXPECT_EQ(0, signal1(2));
+    EXPECT_FALSE(waiter.isReady());
+
+    EXPECT_EQ(1, signal2(3));
+    EXPECT_TRUE(waiter.isReady());
+    EXPECT_EQ(1, std::get<0>(waiter.get<0>()));
+    EXPECT_EQ(3, std::get<0>(waiter.get<1>()));
+}
+
+// The slots of the destroyed waiter are not activated.
+TEST_F(SignalWaiterTest, destroyedWaiterDetachesSlots)
+{
+    comp::Signal<void()> signal;
+    signal.connect(&function);
+    {
+        auto waiter = comp::when_any(signal);
+        EXPECT_FALSE(waiter.isReady());
+    }
+
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(1u, functionCallCount);
+}
+
+// The waiter rejected by a frozen signal detaches the slots it attached to the other signals.
+TEST_F(SignalWaiterTest, frozenSignalRejectsWaiter)
+{
+    comp::Signal<void()> signal;
+    comp::Signal<void()> frozen;
+    frozen.freeze();
+
+    EXPECT_THROW(comp::when_any(signal, frozen), comp::frozen_signal);
+    EXPECT_THROW(comp::when_all(signal, frozen), comp::frozen_signal);
+    EXPECT_EQ(0, signal());
+}
+
+// The waiter waits for signals with return values.
+TEST_F(SignalWaiterTest, waitForSignalWithReturnValue)
+{
+    comp::Signal<int(int)> signal;
+    auto waiter = comp::when_any(signal);
+
+    EXPECT_EQ(1, signal(5));
+    EXPECT_TRUE(waiter.isReady());
+    EXPECT_EQ(5, std::get<0>(waiter.get<0>()));
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The waiting thread is woken up when the signal is activated from an other thread.
+TEST_F(SignalWaiterTest, waitBlocksUntilReady)
+{
+    comp::Signal<void(int)> signal1;
+    comp::Signal<void(int)> signal2;
+    auto waiter = comp::when_all(signal1, signal2);
+    EXPECT_FALSE(waiter.waitFor(std::chrono::milliseconds(1)));
+
+    std::thread emitter([&signal1, &signal2]()
+    {
+        signal1(1);
+        signal2(2);
+    });
+    waiter.wait();
+    emitter.join();
+
+    EXPECT_TRUE(waiter.isReady());
+    EXPECT_EQ(2, std::get<0>(waiter.get<1>()));
+}
+#endif
@@ -0,0 +1,52 @@
+#include "test_base.hpp"
+#include <comp/static_signal.hpp>
+
+namespace
+{
+
+COMP_CONSTINIT comp::StaticSignal<void(int)> s_valueChanged;
+
+using StaticSignalTest = SignalTest;
+
+}
+
+// The static signal allocates the signal on the first connect.
+TEST_F(StaticSignalTest, allocateOnConnect)
+{
+    comp::StaticSignal<void(int)> signal;
+    EXPECT_FALSE(signal.isAllocated());
+    EXPECT_EQ(0, signal(10));
+    EXPECT_FALSE(signal.isAllocated());
+
+    signal.connect(&functionWithIntArgument);
+    EXPECT_TRUE(signal.isAllocated());
+    EXPECT_EQ(1, signal(10));
+    EXPECT_EQ(10u, intValue);
+}
+
+// The application developer can declare the static signals at namespace scope.
+TEST_F(StaticSignalTest, namespaceScopeSignal)
+{
+    auto connection = s_valueChanged.connect(&functionWithIntArgument);
+    EXPECT_EQ(1, s_valueChanged(20));
+    EXPECT_EQ(20u, intValue);
+
+    connection->disconnect();
+    EXPECT_EQ(0, s_valueChanged(30));
+    EXPECT_EQ(20u, intValue);
+}
+
+// The static signal exposes the signal for the other connect overloads.
+TEST_F(StaticSignalTest, connectOverloads)
+{
+    static comp::StaticSignal<void()> signal;
+    comp::vector<int> invocations;
+    signal.connect([&invocations]() { invocations.push_back(1); });
+    signal.connect(10, [&invocations]() { invocations.push_back(2); });
+    signal.signal().connectOnce(&function);
+    EXPECT_EQ(3, signal());
+    EXPECT_EQ(1u, functionCallCount);
+    EXPECT_EQ((comp::vector<int>{2, 1}), invocations);
+
+    signal.signal().disconnect();
+}
@@ -2,6 +2,10 @@
 #include <comp/wraps>
 #include <comp/utilities>
 
+#ifdef COMP_CONFIG_THREAD_ENABLED
+#include <thread>
+#endif
+
 namespace
 {
 
@@ -109,3 +113,113 @@ TEST_F(TrackerTest, deleteOneFromTrackablesInSlotDisconnects_tracker)
     EXPECT_FALSE(connection->isValid());
     EXPECT_EQ(2, signal());
 }
+
+// The application developer should be able to bind a slot to the lifetime of a shared object that is not
+// a DeleteObserver::Notifier.
+TEST_F(TrackerTest, trackWeakPointer)
+{
+    using SignalType = comp::Signal<void()>;
+    SignalType signal;
+    auto object = comp::make_shared<Object>();
+    int invokeCount = 0;
+
+    auto connection = signal.connect(comp::weak_ptr<Object>(object), [&invokeCount]() { ++invokeCount; });
+    EXPECT_EQ(1, signal());
+    EXPECT_EQ(1, invokeCount);
+    EXPECT_TRUE(connection->isValid());
+
+    object.reset();
+    EXPECT_EQ(0, signal());
+    EXPECT_EQ(1, invokeCount);
+    EXPECT_FALSE(connection->isValid());
+}
+
+// The tracked object is kept alive while the slot bound to it is activated.
+TEST_F(TrackerTest, trackedWeakPointerIsLockedDuringActivation)
+{
+    using SignalType = comp::Signal<void()>;
+    SignalType signal;
+    auto object = comp::make_shared<Object>();
+    auto weakObject = comp::weak_ptr<Object>(object);
+
+    auto slot = [&object, &weakObject](comp::ConnectionPtr connection)
+    {
+        object.reset();
+        EXPECT_FALSE(weakObject.expired());
+        EXPECT_TRUE(connection->isValid());
+    };
+    auto connection = signal.connect(weakObject, slot);
+    EXPECT_EQ(1, signal());
+    EXPECT_TRUE(weakObject.expired());
+    EXPECT_EQ(0, signal());
+    EXPECT_FALSE(connection->isValid());
+}
+
+// The connection released while its tracker is deleted is not retained by the notification.
+TEST_F(TrackerTest, releaseConnectionWhileTrackerDeleted)
+{
+    for (auto i = 0; i < 100; ++i)
+    {
+        comp::Signal<void()> signal;
+        auto tracker = comp::make_unique<TestNotifier>();
+        auto connection = signal.connect([](){});
+        connection->watch(*tracker);
+        signal.disconnect();
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+        std::thread releaser([&connection]() { connection.reset(); });
+        tracker.reset();
+        releaser.join();
+#else
+        connection.reset();
+        tracker.reset();
+#endif
+    }
+}
+
+#ifdef COMP_CONFIG_THREAD_ENABLED
+// The observer destroyed while an other thread notifies it waits for the notification before its
+// members are destroyed.
+TEST_F(TrackerTest, deleteObserverWhileNotified)
+{
+    struct Observer : public comp::DeleteObserver
+    {
+        comp::atomic_bool& entered;
+        comp::atomic_bool& sawAlive;
+        comp::atomic_bool alive = true;
+
+        explicit Observer(comp::atomic_bool& entered, comp::atomic_bool& sawAlive)
+            : entered(entered)
+            , sawAlive(sawAlive)
+        {
+        }
+        ~Observer()
+        {
+            stopObserving();
+            alive = false;
+        }
+
+        void notifyDeleted(Notifier&) override
+        {
+            entered = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            sawAlive = alive.load();
+        }
+    };
+
+    comp::atomic_bool entered = false;
+    comp::atomic_bool sawAlive = false;
+    auto observer = comp::make_unique<Observer>(entered, sawAlive);
+    auto notifier = comp::make_unique<TestNotifier>();
+    observer->watch(*notifier);
+
+    std::thread deleter([&notifier]() { notifier.reset(); });
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+    observer.reset();
+    deleter.join();
+    EXPECT_TRUE(sawAlive);
+}
+#endif